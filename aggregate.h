@@ -11,11 +11,18 @@
 
 
 struct AggregateSignature {
-    element_t h;           
-    element_t s;          
+    Element h;           
+    Element s;          
     std::string debug_info;
 };
 
+void computeLagrangeCoefficient(
+    Scalar &outCoeff,
+    const std::vector<int> &allIDs,
+    size_t idx,
+    const mpz_t groupOrder
+);
+
 AggregateSignature aggregateSign(
     TIACParams &params,
     const std::vector<std::pair<int, UnblindSignature>> &partialSigsWithAdmins,
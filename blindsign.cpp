@@ -1,4 +1,8 @@
 #include "blindsign.h"
+#include "trace.h"
+#include "metrics.h"
+#include "scratch.h"
+#include "hashtog1.h"
 #include <openssl/sha.h>
 #include <vector>
 #include <sstream>
@@ -20,115 +24,94 @@ std::string elemToStrG1(element_t elem) {
     return oss.str();
 }
 
-static void hashToZr(element_t outZr, TIACParams &params, const std::vector<element_s*> &g1Elems) {
-    std::ostringstream oss;
-    for (auto ePtr : g1Elems) {
-        oss << elemToStrG1(ePtr);
+static void hashToZr(element_t outZr, TIACParams &params, const std::vector<const std::string*> &hexParts) {
+    std::string data;
+    for (const std::string *part : hexParts) {
+        data += *part;
     }
-    std::string data = oss.str();
     unsigned char digest[SHA512_DIGEST_LENGTH];
     SHA512(reinterpret_cast<const unsigned char*>(data.data()), data.size(), digest);
-    mpz_t tmp;
-    mpz_init(tmp);
-    mpz_import(tmp, SHA512_DIGEST_LENGTH, 1, 1, 0, 0, digest);
-    mpz_mod(tmp, tmp, params.prime_order);
-    element_set_mpz(outZr, tmp);
-    mpz_clear(tmp);
+    Scalar c;
+    scalarFromDigest(c, digest, SHA512_DIGEST_LENGTH, params.prime_order);
+    scalarToElement(outZr, c);
 }
 
-bool CheckKoR(TIACParams &params, element_t com, element_t comi, element_t h, KoRProof &pi_s) {
-    element_t comi_double;
-    element_init_G1(comi_double, params.pairing);
-    element_t g1_s1; 
-    element_init_G1(g1_s1, params.pairing);
+// Imzalayan taraf: transkript imzalanan elemanlardan kodlanir. bsOut'taki
+// *_str onbellegi istekten gelir ve elemanlarla uyusmayabilir; ona
+// guvenilirse kanit imzalanandan farkli bir com'a baglanabilir.
+bool CheckKoR(TIACParams &params, PrepareBlindSignOutput &bsOut) {
+    element_s *com = bsOut.com;
+    element_s *comi = bsOut.comi;
+    element_s *h = bsOut.h;
+    KoRProof &pi_s = bsOut.pi_s;
+    ScratchFrame scratch(params.pairing);
+    element_s *comi_double = scratch.g1();
+    element_s *g1_s1 = scratch.g1();
     element_pow_zn(g1_s1, params.g1, pi_s.s1);
-    element_t h1_s2; 
-    element_init_G1(h1_s2, params.pairing);
+    element_s *h1_s2 = scratch.g1();
     element_pow_zn(h1_s2, params.h1, pi_s.s2);
-    element_t comi_c; 
-    element_init_G1(comi_c, params.pairing);
+    element_s *comi_c = scratch.g1();
     element_pow_zn(comi_c, comi, pi_s.c);
     element_mul(comi_double, g1_s1, h1_s2);
-    element_clear(g1_s1);
-    element_clear(h1_s2);
     element_mul(comi_double, comi_double, comi_c);
-    element_clear(comi_c);
-    element_t com_double;
-    element_init_G1(com_double, params.pairing);
-    element_t g1_s3;
-    element_init_G1(g1_s3, params.pairing);
+    element_s *com_double = scratch.g1();
+    element_s *g1_s3 = scratch.g1();
     element_pow_zn(g1_s3, params.g1, pi_s.s3);
-    element_t h_s2;
-    element_init_G1(h_s2, params.pairing);
+    element_s *h_s2 = scratch.g1();
     element_pow_zn(h_s2, h, pi_s.s2);
-    element_t com_c;
-    element_init_G1(com_c, params.pairing);
+    element_s *com_c = scratch.g1();
     element_pow_zn(com_c, com, pi_s.c);
     element_mul(com_double, g1_s3, h_s2);
     element_mul(com_double, com_double, com_c);
-    element_clear(g1_s3);
-    element_clear(h_s2);
-    element_clear(com_c);
-    element_t cprime;
-    element_init_Zr(cprime, params.pairing);
-    std::vector<element_s*> toHash;
-    toHash.reserve(7);
-    toHash.push_back(params.g1);
-    toHash.push_back(h);
-    toHash.push_back(params.h1);
-    toHash.push_back(com);
-    toHash.push_back(com_double);
-    toHash.push_back(comi);
-    toHash.push_back(comi_double);
+    element_s *cprime = scratch.zr();
+    std::string g1Hex = elemToStrG1(params.g1), h1Hex = elemToStrG1(params.h1);
+    std::string hHex = elemToStrG1(h), comHex = elemToStrG1(com), comiHex = elemToStrG1(comi);
+    std::string comDoubleHex = elemToStrG1(com_double), comiDoubleHex = elemToStrG1(comi_double);
+    std::vector<const std::string*> toHash = {
+        &g1Hex,
+        &hHex,
+        &h1Hex,
+        &comHex,
+        &comDoubleHex,
+        &comiHex,
+        &comiDoubleHex
+    };
     hashToZr(cprime, params, toHash);
-    bool ok = (element_cmp(cprime, pi_s.c) == 0);
-    element_clear(comi_double);
-    element_clear(com_double);
-    element_clear(cprime);
-    return ok;
+    return element_cmp(cprime, pi_s.c) == 0;
 }
 
-BlindSignature blindSign(TIACParams &params, PrepareBlindSignOutput &bsOut, mpz_t xm, mpz_t ym, int adminId, int voterId) {
-    bool ok = CheckKoR(params, bsOut.com, bsOut.comi, bsOut.h, bsOut.pi_s);
+BlindSignature blindSign(TIACParams &params, PrepareBlindSignOutput &bsOut, const Scalar &x, const Scalar &y, int adminId, int voterId, element_s *comiHash) {
+    bool ok;
+    {
+        TRACE_SPAN("CheckKoR", voterId);
+        ok = CheckKoR(params, bsOut);
+    }
     if(!ok) {
+        static MetricCounter &korFailures = metricCounter("evoting_blindsign_kor_failures_total", "blindSign icinde reddedilen KoR kanitlari");
+        korFailures.inc();
         throw std::runtime_error("blindSign: KoR check failed");
     }
-    element_t hprime;
-    element_init_G1(hprime, params.pairing);
+    bool hashOk;
     {
-        std::string s = elemToStrG1(bsOut.comi);
-        element_from_hash(hprime, s.data(), s.size());
+        ScratchFrame scratch(params.pairing);
+        element_s *hprime = comiHash;
+        if (!hprime) {
+            hprime = scratch.g1();
+            hashToG1(params, hprime, bsOut.comi);
+        }
+        hashOk = element_cmp(hprime, bsOut.h) == 0;
     }
-    if(element_cmp(hprime, bsOut.h) != 0) {
-        element_clear(hprime);
+    if(!hashOk) {
+        static MetricCounter &hashMismatches = metricCounter("evoting_blindsign_hash_mismatch_total", "blindSign icinde Hash(comi) != h");
+        hashMismatches.inc();
         throw std::runtime_error("blindSign: Hash(comi) != h => hata");
     }
-    element_clear(hprime);
     BlindSignature sig;
-    element_init_G1(sig.h, params.pairing);
-    element_init_G1(sig.cm, params.pairing);
+    sig.h.init(params.pairing, Group::G1);
+    sig.cm.init(params.pairing, Group::G1);
     element_set(sig.h, bsOut.h);
-    element_t hx;
-    element_init_G1(hx, params.pairing);
-    {
-        element_t expX;
-        element_init_Zr(expX, params.pairing);
-        element_set_mpz(expX, xm);
-        element_pow_zn(hx, bsOut.h, expX);
-        element_clear(expX);
-    }
-    element_t comy;
-    element_init_G1(comy, params.pairing);
-    {
-        element_t expY;
-        element_init_Zr(expY, params.pairing);
-        element_set_mpz(expY, ym);
-        element_pow_zn(comy, bsOut.com, expY);
-        element_clear(expY);
-    }
-    element_mul(sig.cm, hx, comy);
-    element_clear(hx);
-    element_clear(comy);
+    // cm = h^x * com^y
+    scalarPow2(sig.cm, bsOut.h, x, bsOut.com, y);
     sig.adminId = adminId;
     sig.voterId = voterId;
     return sig;
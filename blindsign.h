@@ -9,17 +9,16 @@
 
 std::string elemToStrG1(element_t elem);
 
+// Transkript bsOut.h/com/comi elemanlarindan kodlanir; *_str onbellegi
+// kullanilmaz (yalnizca secmen tarafi icin)
 bool CheckKoR(
     TIACParams &params,
-    element_t com,
-    element_t comi,
-    element_t h,
-    KoRProof &pi_s
+    PrepareBlindSignOutput &bsOut
 );
 
 struct BlindSignature {
-    element_t h;   
-    element_t cm;  
+    Element h;   
+    Element cm;  
     int adminId;  
     int voterId;   
 };
@@ -27,10 +26,13 @@ struct BlindSignature {
 BlindSignature blindSign(
     TIACParams &params,
     PrepareBlindSignOutput &bsOut,
-    mpz_t xm,
-    mpz_t ym,
+    const Scalar &x,
+    const Scalar &y,
     int adminId,
-    int voterId
+    int voterId,
+    // Hash(comi) onceden (ornegin hashToG1Batch ile) hesaplandiysa verilir;
+    // nullptr ise blindSign kendisi hesaplar
+    element_s *comiHash = nullptr
 );
 
 #endif
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "checkkorverify.h"
+#include "scratch.h"
 #include <openssl/sha.h>
 #include <sstream>
 #include <iomanip>
@@ -7,24 +8,6 @@
 #include <iostream>
 
 
-static void copyConstElement(element_t dest, const element_t src, pairing_t pairing, int element_type) {
-    switch (element_type) {
-        case 1: 
-            element_init_G1(dest, pairing);
-            break;
-        case 2: 
-            element_init_G2(dest, pairing);
-            break;
-        default: 
-            element_init_Zr(dest, pairing);
-            break;
-    }
-    element_t temp;
-    temp[0] = *((element_s*)(&src[0]));
-    element_set(dest, temp);
-}
-
-
 static std::vector<unsigned char> hexToBytes(const std::string &hex) {
     std::vector<unsigned char> bytes;
     bytes.reserve(hex.size() / 2);
@@ -64,117 +47,67 @@ static void stringToElementG1(element_t result, const std::string &hexStr, pairi
 }
 
 
-bool checkKoRVerify(TIACParams &params,const ProveCredentialOutput &proveRes,const MasterVerKey &mvk, const std::string &com_str, const element_t h_agg){
-    element_t k_copy, c_copy, s1_copy, s2_copy, s3_copy;
-    copyConstElement(k_copy,  proveRes.k,  params.pairing, 2);
-    copyConstElement(c_copy,  proveRes.c,  params.pairing, 0);
-    copyConstElement(s1_copy, proveRes.s1, params.pairing, 0);
-    copyConstElement(s2_copy, proveRes.s2, params.pairing, 0);
-    copyConstElement(s3_copy, proveRes.s3, params.pairing, 0);
-    element_t alpha2_copy, beta2_copy;
-    copyConstElement(alpha2_copy, mvk.alpha2, params.pairing, 2); 
-    copyConstElement(beta2_copy,  mvk.beta2,  params.pairing, 2);
-    element_t h_copy;
-    copyConstElement(h_copy, h_agg, params.pairing, 1);
-    element_t com_elem;
-    stringToElementG1(com_elem, com_str, params.pairing);
-    element_t one_minus_c;
-    element_init_Zr(one_minus_c, params.pairing);
-    element_t one;
-    element_init_Zr(one, params.pairing);
-    element_set1(one);               
-    element_sub(one_minus_c, one, c_copy);  
-    element_t k_prime_prime;
-    element_init_G2(k_prime_prime, params.pairing);
-    element_t g2_s1;
-    element_init_G2(g2_s1, params.pairing);
-    element_pow_zn(g2_s1, params.g2, s1_copy);
-    element_t alpha2_pow;
-    element_init_G2(alpha2_pow, params.pairing);
-    element_pow_zn(alpha2_pow, alpha2_copy, one_minus_c);
-    element_t k_pow_c;
-    element_init_G2(k_pow_c, params.pairing);
-    element_pow_zn(k_pow_c, k_copy, c_copy);
-    element_t beta2_s2;
-    element_init_G2(beta2_s2, params.pairing);
-    element_pow_zn(beta2_s2, beta2_copy, s2_copy);
+std::string koRVerifyTranscript(TIACParams &params, element_t k, element_t c, element_t s1, element_t s2, element_t s3, const MasterVerKey &mvk, element_t com_elem, element_t h){
+    element_s *alpha2 = mvk.alpha2;
+    element_s *beta2 = mvk.beta2;
+    ScratchFrame scratch(params.pairing);
+    element_s *one_minus_c = scratch.zr();
+    element_set1(one_minus_c);
+    element_sub(one_minus_c, one_minus_c, c);
+    element_s *k_prime_prime = scratch.g2();
+    element_s *g2_s1 = scratch.g2();
+    element_pow_zn(g2_s1, params.g2, s1);
+    element_s *alpha2_pow = scratch.g2();
+    element_pow_zn(alpha2_pow, alpha2, one_minus_c);
+    element_s *k_pow_c = scratch.g2();
+    element_pow_zn(k_pow_c, k, c);
+    element_s *beta2_s2 = scratch.g2();
+    element_pow_zn(beta2_s2, beta2, s2);
     element_set(k_prime_prime, g2_s1);
     element_mul(k_prime_prime, k_prime_prime, alpha2_pow);
     element_mul(k_prime_prime, k_prime_prime, k_pow_c);
     element_mul(k_prime_prime, k_prime_prime, beta2_s2);
-    element_t com_prime_prime;
-    element_init_G1(com_prime_prime, params.pairing);
-    element_t g1_s3;
-    element_init_G1(g1_s3, params.pairing);
-    element_pow_zn(g1_s3, params.g1, s3_copy);
-    element_t h_s2;
-    element_init_G1(h_s2, params.pairing);
-    element_pow_zn(h_s2, h_copy, s2_copy);
-    element_t com_pow_c;
-    element_init_G1(com_pow_c, params.pairing);
-    element_pow_zn(com_pow_c, com_elem, c_copy);
+    element_s *com_prime_prime = scratch.g1();
+    element_s *g1_s3 = scratch.g1();
+    element_pow_zn(g1_s3, params.g1, s3);
+    element_s *h_s2 = scratch.g1();
+    element_pow_zn(h_s2, h, s2);
+    element_s *com_pow_c = scratch.g1();
+    element_pow_zn(com_pow_c, com_elem, c);
     element_set(com_prime_prime, g1_s3);
     element_mul(com_prime_prime, com_prime_prime, h_s2);
     element_mul(com_prime_prime, com_prime_prime, com_pow_c);
     std::ostringstream hashOSS;
     hashOSS << elementToHexStr(params.g1)
             << elementToHexStr(params.g2)
-            << elementToHexStr(h_copy)
+            << elementToHexStr(h)
             << elementToHexStr(com_elem)
             << elementToHexStr(com_prime_prime)
-            << elementToHexStr(k_copy)
+            << elementToHexStr(k)
             << elementToHexStr(k_prime_prime);
-    std::string hashInput = hashOSS.str();
+    return hashOSS.str();
+}
+
+bool koRChallengeMatches(TIACParams &params, const unsigned char *digest, element_t c){
+    Scalar c_prime;
+    scalarFromDigest(c_prime, digest, SHA512_DIGEST_LENGTH, params.prime_order);
+    ScratchFrame scratch(params.pairing);
+    element_s *c_prime_elem = scratch.zr();
+    scalarToElement(c_prime_elem, c_prime);
+    return element_cmp(c_prime_elem, c) == 0;
+}
+
+bool checkKoRVerifyElements(TIACParams &params, element_t k, element_t c, element_t s1, element_t s2, element_t s3, const MasterVerKey &mvk, element_t com_elem, element_t h){
+    std::string hashInput = koRVerifyTranscript(params, k, c, s1, s2, s3, mvk, com_elem, h);
     unsigned char hashDigest[SHA512_DIGEST_LENGTH];
     SHA512(reinterpret_cast<const unsigned char*>(hashInput.data()), hashInput.size(), hashDigest);
-    std::ostringstream hashFinalOSS;
-    hashFinalOSS << std::hex << std::setfill('0');
-    for (int i = 0; i < SHA512_DIGEST_LENGTH; i++) {
-        hashFinalOSS << std::setw(2) << (int)hashDigest[i];
-    }
-    std::string c_prime_hex = hashFinalOSS.str();
-    mpz_t c_prime_mpz;
-    mpz_init(c_prime_mpz);
-    if (mpz_set_str(c_prime_mpz, c_prime_hex.c_str(), 16) != 0) {
-        mpz_clear(c_prime_mpz);
-        element_clear(k_copy); element_clear(c_copy); element_clear(s1_copy);
-        element_clear(s2_copy); element_clear(s3_copy);
-        element_clear(alpha2_copy); element_clear(beta2_copy);
-        element_clear(h_copy); element_clear(com_elem);
-        element_clear(one_minus_c); element_clear(one);
-        element_clear(k_prime_prime); element_clear(g2_s1);
-        element_clear(alpha2_pow); element_clear(k_pow_c);
-        element_clear(beta2_s2); element_clear(com_prime_prime);
-        element_clear(g1_s3); element_clear(h_s2);
-        element_clear(com_pow_c);
-        return false;
-    }
-    mpz_mod(c_prime_mpz, c_prime_mpz, params.prime_order);
-    element_t c_prime;
-    element_init_Zr(c_prime, params.pairing);
-    element_set_mpz(c_prime, c_prime_mpz);
-    mpz_clear(c_prime_mpz);
-    bool isEqual = (element_cmp(c_prime, c_copy) == 0);
-    element_clear(k_copy);
-    element_clear(c_copy);
-    element_clear(s1_copy);
-    element_clear(s2_copy);
-    element_clear(s3_copy);
-    element_clear(alpha2_copy);
-    element_clear(beta2_copy);
-    element_clear(h_copy);
+    return koRChallengeMatches(params, hashDigest, c);
+}
+
+bool checkKoRVerify(TIACParams &params,const ProveCredentialOutput &proveRes,const MasterVerKey &mvk, const std::string &com_str, const Element &h_agg){
+    element_t com_elem;
+    stringToElementG1(com_elem, com_str, params.pairing);
+    bool isEqual = checkKoRVerifyElements(params, proveRes.k, proveRes.c, proveRes.s1, proveRes.s2, proveRes.s3, mvk, com_elem, h_agg);
     element_clear(com_elem);
-    element_clear(one_minus_c);
-    element_clear(one);
-    element_clear(k_prime_prime);
-    element_clear(g2_s1);
-    element_clear(alpha2_pow);
-    element_clear(k_pow_c);
-    element_clear(beta2_s2);
-    element_clear(com_prime_prime);
-    element_clear(g1_s3);
-    element_clear(h_s2);
-    element_clear(com_pow_c);
-    element_clear(c_prime);
-    return isEqual; 
+    return isEqual;
 }
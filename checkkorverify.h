@@ -8,12 +8,41 @@
 #include <string>
 
 
+// c'' = Hash(g1, g2, h, com, com'', k, k'') girdisi; toplu dogrulamada
+// ozetler hashMany ile birlikte alinir
+std::string koRVerifyTranscript(
+    TIACParams &params,
+    element_t k,
+    element_t c,
+    element_t s1,
+    element_t s2,
+    element_t s3,
+    const MasterVerKey &mvk,
+    element_t com,
+    element_t h_agg
+);
+
+// SHA-512 ozetinden uretilen skaler c ile esit mi
+bool koRChallengeMatches(TIACParams &params, const unsigned char *digest, element_t c);
+
+bool checkKoRVerifyElements(
+    TIACParams &params,
+    element_t k,
+    element_t c,
+    element_t s1,
+    element_t s2,
+    element_t s3,
+    const MasterVerKey &mvk,
+    element_t com,
+    element_t h_agg
+);
+
 bool checkKoRVerify(
     TIACParams &params,
     const ProveCredentialOutput &proveRes,
     const MasterVerKey &mvk,  
     const std::string &com_str,
-    const element_t h_agg
+    const Element &h_agg
 );
 
 #endif // CHECKKORVERIFY_H
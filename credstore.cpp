@@ -0,0 +1,284 @@
+#include "credstore.h"
+#include "pairinginverify.h"
+#include "checkkorverify.h"
+#include "hashmany.h"
+#include <openssl/sha.h>
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char kMagic[8] = {'E', 'V', 'C', 'R', 'E', 'D', '0', '1'};
+static const size_t kFixedHeader = 32;
+static const size_t kHeaderAlign = 4096;
+static const size_t kFlushBytes = 1 << 20;
+static const size_t kVerifyGrain = 32;
+
+static void putU32(std::vector<unsigned char> &out, uint32_t v) {
+    for (int i = 0; i < 4; i++) {
+        out.push_back((unsigned char)(v >> (8 * i)));
+    }
+}
+
+static uint32_t getU32(const unsigned char *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void putRaw(std::vector<unsigned char> &out, element_s *e) {
+    size_t at = out.size();
+    out.resize(at + element_length_in_bytes(e));
+    element_to_bytes(out.data() + at, e);
+}
+
+static std::string sysError(const std::string &what, const std::string &path) {
+    return what + " '" + path + "': " + std::strerror(errno);
+}
+
+static void writeAll(int fd, const unsigned char *data, size_t len) {
+    while (len > 0) {
+        ssize_t n = ::write(fd, data, len);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error(std::string("CredStoreWriter: write failed: ") + std::strerror(errno));
+        }
+        data += n;
+        len -= (size_t)n;
+    }
+}
+
+static std::vector<unsigned char> buildHeader(TIACParams &params, const MasterVerKey &mvk, size_t recordSize) {
+    std::vector<unsigned char> body;
+    putRaw(body, params.g1);
+    putRaw(body, params.g2);
+    putRaw(body, params.h1);
+    putRaw(body, mvk.alpha2);
+    putRaw(body, mvk.beta2);
+    putRaw(body, mvk.beta1);
+
+    size_t used = kFixedHeader + params.paramText.size() + body.size();
+    size_t headerSize = (used + kHeaderAlign - 1) / kHeaderAlign * kHeaderAlign;
+
+    std::vector<unsigned char> header(kMagic, kMagic + 8);
+    putU32(header, (uint32_t)headerSize);
+    putU32(header, (uint32_t)recordSize);
+    putU32(header, (uint32_t)pairing_length_in_bytes_G1(params.pairing));
+    putU32(header, (uint32_t)pairing_length_in_bytes_G2(params.pairing));
+    putU32(header, (uint32_t)pairing_length_in_bytes_Zr(params.pairing));
+    putU32(header, (uint32_t)params.paramText.size());
+    header.insert(header.end(), params.paramText.begin(), params.paramText.end());
+    header.insert(header.end(), body.begin(), body.end());
+    header.resize(headerSize, 0);
+    return header;
+}
+
+CredStoreWriter::CredStoreWriter(TIACParams &params, const MasterVerKey &mvk, const std::string &path)
+    : fd_(-1), records_(0) {
+    g1_ = (size_t)pairing_length_in_bytes_G1(params.pairing);
+    g2_ = (size_t)pairing_length_in_bytes_G2(params.pairing);
+    zr_ = (size_t)pairing_length_in_bytes_Zr(params.pairing);
+    recordSize_ = 4 * g1_ + g2_ + 4 * zr_;
+    std::vector<unsigned char> header = buildHeader(params, mvk, recordSize_);
+
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd_ < 0) {
+        throw std::runtime_error(sysError("CredStoreWriter: cannot open", path));
+    }
+    struct stat st;
+    if (fstat(fd_, &st) != 0) {
+        ::close(fd_);
+        throw std::runtime_error(sysError("CredStoreWriter: cannot stat", path));
+    }
+    size_t size = (size_t)st.st_size;
+    if (size == 0) {
+        try {
+            writeAll(fd_, header.data(), header.size());
+        } catch (...) {
+            ::close(fd_);
+            throw;
+        }
+    } else {
+        std::vector<unsigned char> existing(header.size());
+        if (size < header.size() || pread(fd_, existing.data(), existing.size(), 0) != (ssize_t)existing.size()
+            || existing != header) {
+            ::close(fd_);
+            throw std::runtime_error("CredStoreWriter: '" + path + "' was written for different parameters or keys");
+        }
+        // Yarim kalmis son kayit kesilir
+        records_ = (size - header.size()) / recordSize_;
+        size_t whole = header.size() + records_ * recordSize_;
+        if (whole != size && ftruncate(fd_, (off_t)whole) != 0) {
+            ::close(fd_);
+            throw std::runtime_error(sysError("CredStoreWriter: cannot truncate", path));
+        }
+    }
+    if (lseek(fd_, 0, SEEK_END) < 0) {
+        ::close(fd_);
+        throw std::runtime_error(sysError("CredStoreWriter: cannot seek", path));
+    }
+    buffer_.reserve(kFlushBytes + recordSize_);
+}
+
+CredStoreWriter::~CredStoreWriter() {
+    try {
+        flush();
+    } catch (...) {
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+void CredStoreWriter::putElement(element_s *e, size_t width) {
+    if ((size_t)element_length_in_bytes(e) != width) {
+        throw std::runtime_error("CredStoreWriter: element width does not match record layout");
+    }
+    size_t at = buffer_.size();
+    buffer_.resize(at + width);
+    element_to_bytes(buffer_.data() + at, e);
+}
+
+void CredStoreWriter::append(const ProveCredentialOutput &proof, const Element &com, const Element &h_agg) {
+    putElement(proof.sigmaRnd.h, g1_);
+    putElement(proof.sigmaRnd.s, g1_);
+    putElement(proof.k, g2_);
+    putElement(proof.c, zr_);
+    putElement(proof.s1, zr_);
+    putElement(proof.s2, zr_);
+    putElement(proof.s3, zr_);
+    putElement(com, g1_);
+    putElement(h_agg, g1_);
+    records_++;
+    if (buffer_.size() >= kFlushBytes) {
+        flush();
+    }
+}
+
+void CredStoreWriter::flush() {
+    if (buffer_.empty()) {
+        return;
+    }
+    writeAll(fd_, buffer_.data(), buffer_.size());
+    buffer_.clear();
+}
+
+CredStoreReader::CredStoreReader(const std::string &path) : fd_(-1), map_(nullptr), mapSize_(0) {
+    fd_ = ::open(path.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+        throw std::runtime_error(sysError("CredStoreReader: cannot open", path));
+    }
+    struct stat st;
+    if (fstat(fd_, &st) != 0 || (size_t)st.st_size < kFixedHeader) {
+        ::close(fd_);
+        throw std::runtime_error("CredStoreReader: '" + path + "' is not a credential store");
+    }
+    mapSize_ = (size_t)st.st_size;
+    void *m = mmap(nullptr, mapSize_, PROT_READ, MAP_PRIVATE, fd_, 0);
+    if (m == MAP_FAILED) {
+        ::close(fd_);
+        throw std::runtime_error(sysError("CredStoreReader: mmap failed for", path));
+    }
+    map_ = (unsigned char*)m;
+    madvise(map_, mapSize_, MADV_SEQUENTIAL);
+    madvise(map_, mapSize_, MADV_WILLNEED);
+
+    size_t headerSize = getU32(map_ + 8);
+    recordSize_ = getU32(map_ + 12);
+    g1_ = getU32(map_ + 16);
+    g2_ = getU32(map_ + 20);
+    zr_ = getU32(map_ + 24);
+    size_t textLen = getU32(map_ + 28);
+    if (std::memcmp(map_, kMagic, 8) != 0 || headerSize > mapSize_ || recordSize_ == 0 || recordSize_ != 4 * g1_ + g2_ + 4 * zr_
+        || kFixedHeader + textLen + 3 * g1_ + 3 * g2_ > headerSize) {
+        munmap(map_, mapSize_);
+        ::close(fd_);
+        throw std::runtime_error("CredStoreReader: '" + path + "' has a corrupt header");
+    }
+    paramText_.assign((const char*)map_ + kFixedHeader, textLen);
+    publicKeys_ = map_ + kFixedHeader + textLen;
+    records_ = map_ + headerSize;
+    count_ = (mapSize_ - headerSize) / recordSize_;
+}
+
+CredStoreReader::~CredStoreReader() {
+    if (map_) {
+        munmap(map_, mapSize_);
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+void CredStoreReader::loadPublic(TIACParams &params, MasterVerKey &mvk) const {
+    if ((size_t)pairing_length_in_bytes_G1(params.pairing) != g1_ || (size_t)pairing_length_in_bytes_G2(params.pairing) != g2_
+        || (size_t)pairing_length_in_bytes_Zr(params.pairing) != zr_) {
+        throw std::runtime_error("CredStoreReader: pairing does not match store layout");
+    }
+    unsigned char *p = const_cast<unsigned char*>(publicKeys_);
+    p += element_from_bytes(params.g1, p);
+    p += element_from_bytes(params.g2, p);
+    p += element_from_bytes(params.h1, p);
+    mvk.alpha2.init(params.pairing, Group::G2);
+    mvk.beta2.init(params.pairing, Group::G2);
+    mvk.beta1.init(params.pairing, Group::G1);
+    p += element_from_bytes(mvk.alpha2, p);
+    p += element_from_bytes(mvk.beta2, p);
+    element_from_bytes(mvk.beta1, p);
+}
+
+size_t verifyStore(TIACParams &params, const MasterVerKey &mvk, const CredStoreReader &store, std::vector<char> &ok) {
+    ok.assign(store.count(), 0);
+    const size_t g1 = store.g1Bytes(), g2 = store.g2Bytes(), zr = store.zrBytes();
+    std::atomic<size_t> valid(0);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, store.count(), kVerifyGrain),
+        [&](const tbb::blocked_range<size_t> &r) {
+            Element h(params.pairing, Group::G1), s(params.pairing, Group::G1);
+            Element k(params.pairing, Group::G2);
+            Element c(params.pairing, Group::Zr), s1(params.pairing, Group::Zr);
+            Element s2(params.pairing, Group::Zr), s3(params.pairing, Group::Zr);
+            Element com(params.pairing, Group::G1), hAgg(params.pairing, Group::G1);
+            std::vector<size_t> pending;
+            std::vector<std::string> transcripts;
+            pending.reserve(r.size());
+            transcripts.reserve(r.size());
+            for (size_t i = r.begin(); i != r.end(); ++i) {
+                unsigned char *p = const_cast<unsigned char*>(store.record(i));
+                element_from_bytes(h, p);    p += g1;
+                element_from_bytes(s, p);    p += g1;
+                element_from_bytes(k, p);    p += g2;
+                element_from_bytes(c, p);    p += zr;
+                element_from_bytes(s1, p);   p += zr;
+                element_from_bytes(s2, p);   p += zr;
+                element_from_bytes(s3, p);   p += zr;
+                element_from_bytes(com, p);  p += g1;
+                element_from_bytes(hAgg, p);
+                if (!pairingCheckElements(params, h, s, k)) {
+                    continue;
+                }
+                pending.push_back(i);
+                transcripts.push_back(koRVerifyTranscript(params, k, c, s1, s2, s3, mvk, com, hAgg));
+            }
+            std::vector<unsigned char> digests(transcripts.size() * SHA512_DIGEST_LENGTH);
+            hashMany(transcripts, digests.data());
+            size_t localValid = 0;
+            for (size_t j = 0; j < pending.size(); j++) {
+                // c kaydin basindaki h, s, k alanlarindan sonra gelir
+                unsigned char *p = const_cast<unsigned char*>(store.record(pending[j])) + 2 * g1 + g2;
+                element_from_bytes(c, p);
+                if (!koRChallengeMatches(params, &digests[j * SHA512_DIGEST_LENGTH], c)) {
+                    continue;
+                }
+                ok[pending[j]] = 1;
+                localValid++;
+            }
+            valid.fetch_add(localValid, std::memory_order_relaxed);
+        });
+    return valid.load();
+}
@@ -0,0 +1,87 @@
+#ifndef CREDSTORE_H
+#define CREDSTORE_H
+
+#include "setup.h"
+#include "keygen.h"
+#include "provecredential.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Yalnizca sona eklenen gosterim deposu.
+//
+// Baslik (headerSize byte, 4096'nin kati):
+//   "EVCRED01" | u32 headerSize | u32 recordSize | u32 g1 | u32 g2 | u32 zr |
+//   u32 paramTextLen | paramText | g1 | g2 | h1 | alpha2 | beta2 | beta1
+// Kayitlar (recordSize sabit adim, element_to_bytes formati):
+//   sigmaRnd.h | sigmaRnd.s | k | c | s1 | s2 | s3 | com | h_agg
+// Tamsayilar little-endian. Kayit sayisi dosya boyutundan hesaplanir; yarim
+// yazilmis son kayit okunurken yok sayilir, yazici acilista onu keser.
+
+class CredStoreWriter {
+public:
+    // Dosya yoksa baslik yazilir; varsa basligin ayni parametre ve
+    // anahtarlara ait oldugu dogrulanir.
+    CredStoreWriter(TIACParams &params, const MasterVerKey &mvk, const std::string &path);
+    ~CredStoreWriter();
+
+    CredStoreWriter(const CredStoreWriter &) = delete;
+    CredStoreWriter &operator=(const CredStoreWriter &) = delete;
+
+    void append(const ProveCredentialOutput &proof, const Element &com, const Element &h_agg);
+    void flush();
+    size_t records() const { return records_; }
+
+private:
+    void putElement(element_s *e, size_t width);
+
+    int fd_;
+    size_t g1_, g2_, zr_;
+    size_t recordSize_;
+    size_t records_;
+    std::vector<unsigned char> buffer_;
+};
+
+class CredStoreReader {
+public:
+    explicit CredStoreReader(const std::string &path);
+    ~CredStoreReader();
+
+    CredStoreReader(const CredStoreReader &) = delete;
+    CredStoreReader &operator=(const CredStoreReader &) = delete;
+
+    const std::string &paramText() const { return paramText_; }
+    size_t count() const { return count_; }
+    size_t recordSize() const { return recordSize_; }
+    const unsigned char *record(size_t i) const { return records_ + i * recordSize_; }
+
+    // params setupParamsFromText(paramText()) ile kurulmus olmali; g1, g2,
+    // h1 ve ana dogrulama anahtari basliktan yuklenir.
+    void loadPublic(TIACParams &params, MasterVerKey &mvk) const;
+
+    size_t g1Bytes() const { return g1_; }
+    size_t g2Bytes() const { return g2_; }
+    size_t zrBytes() const { return zr_; }
+
+private:
+    int fd_;
+    unsigned char *map_;
+    size_t mapSize_;
+    size_t g1_, g2_, zr_;
+    size_t recordSize_;
+    size_t count_;
+    std::string paramText_;
+    const unsigned char *publicKeys_;
+    const unsigned char *records_;
+};
+
+// Tum kayitlari tum cekirdeklerde pairing + KoR kontrolunden gecirir.
+// ok[i] == 1 ise i. kayit gecerli.
+size_t verifyStore(
+    TIACParams &params,
+    const MasterVerKey &mvk,
+    const CredStoreReader &store,
+    std::vector<char> &ok
+);
+
+#endif
@@ -1,27 +1,13 @@
 #include "didgen.h"
+#include "rng.h"
+#include "hashmany.h"
 #include <openssl/sha.h>  
 #include <iomanip>
 #include <sstream>
 #include <vector>
-#include <random>
 #include <stdexcept>
 
-static void random_mpz_modp(mpz_t rop, const mpz_t p) {
-    thread_local std::random_device rd;
-    thread_local std::mt19937_64 gen(rd());
-    size_t bits = mpz_sizeinbase(p, 2);
-    size_t bytes = (bits + 7) / 8; 
-    std::vector<unsigned char> buf(bytes);
-    for (size_t i = 0; i < bytes; i++) {
-        buf[i] = static_cast<unsigned char>(gen() & 0xFF);
-    }
-    mpz_import(rop, bytes, 1, 1, 0, 0, buf.data());
-    mpz_mod(rop, rop, p);
-}
-
-static std::string sha512_hex(const std::string &input) {
-    unsigned char hash[SHA512_DIGEST_LENGTH];
-    SHA512(reinterpret_cast<const unsigned char*>(input.data()), input.size(), hash);
+static std::string digestHex(const unsigned char *hash) {
     std::ostringstream oss;
     oss << std::hex << std::setfill('0');
     for (size_t i = 0; i < SHA512_DIGEST_LENGTH; i++) {
@@ -30,13 +16,37 @@ static std::string sha512_hex(const std::string &input) {
     return oss.str();
 }
 
-DID createDID(const TIACParams &params, const std::string &userID) {
-    DID result;
-    mpz_init(result.x);
-    random_mpz_modp(result.x, params.prime_order);
-    char* x_str = mpz_get_str(nullptr, 10, result.x);
+static std::string sha512_hex(const std::string &input) {
+    unsigned char hash[SHA512_DIGEST_LENGTH];
+    SHA512(reinterpret_cast<const unsigned char*>(input.data()), input.size(), hash);
+    return digestHex(hash);
+}
+
+static std::string saltedInput(const std::string &userID, const mpz_t x) {
+    char* x_str = mpz_get_str(nullptr, 10, x);
     std::string concat_str = userID + x_str;
-    result.did = sha512_hex(concat_str);
     free(x_str);
+    return concat_str;
+}
+
+DID createDID(const TIACParams &params, const std::string &userID) {
+    DID result;
+    randomMpzModp(result.x, params.prime_order);
+    result.did = sha512_hex(saltedInput(userID, result.x));
+    return result;
+}
+
+std::vector<DID> createDIDs(const TIACParams &params, const std::vector<std::string> &userIDs) {
+    std::vector<DID> result(userIDs.size());
+    std::vector<std::string> inputs(userIDs.size());
+    for (size_t i = 0; i < userIDs.size(); i++) {
+        randomMpzModp(result[i].x, params.prime_order);
+        inputs[i] = saltedInput(userIDs[i], result[i].x);
+    }
+    std::vector<unsigned char> digests(inputs.size() * SHA512_DIGEST_LENGTH);
+    hashMany(inputs, digests.data());
+    for (size_t i = 0; i < result.size(); i++) {
+        result[i].did = digestHex(digests.data() + i * SHA512_DIGEST_LENGTH);
+    }
     return result;
 }
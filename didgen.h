@@ -3,12 +3,16 @@
 
 #include "setup.h"
 #include <string>
+#include <vector>
 
 struct DID {
-    mpz_t x;
+    Mpz x;
     std::string did;
 };
 
 DID createDID(const TIACParams &params, const std::string &userID);
 
+// createDID ile ayni sonuc; tum SHA-512'ler tek hashMany cagrisinda
+std::vector<DID> createDIDs(const TIACParams &params, const std::vector<std::string> &userIDs);
+
 #endif
@@ -0,0 +1,166 @@
+#include "doubleshow.h"
+#include <openssl/sha.h>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <cstring>
+
+ShowTag computeShowTag(element_t com, element_t h_agg) {
+    int comLen = element_length_in_bytes(com);
+    int hLen = element_length_in_bytes(h_agg);
+    std::vector<unsigned char> buf(comLen + hLen);
+    element_to_bytes(buf.data(), com);
+    element_to_bytes(buf.data() + comLen, h_agg);
+    unsigned char digest[SHA512_DIGEST_LENGTH];
+    SHA512(buf.data(), buf.size(), digest);
+    ShowTag tag;
+    std::memcpy(&tag.hi, digest, sizeof(tag.hi));
+    std::memcpy(&tag.lo, digest + sizeof(tag.hi), sizeof(tag.lo));
+    if (tag.hi == 0) tag.hi = 1;
+    tag.lo |= 1;
+    return tag;
+}
+
+static size_t nextPow2(size_t v) {
+    size_t p = 1;
+    while (p < v) p <<= 1;
+    return p;
+}
+
+static inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+DoubleShowIndex::DoubleShowIndex(size_t expectedEntries)
+    : baseCapacity_(nextPow2(expectedEntries * 2 < 1024 ? 1024 : expectedEntries * 2)),
+      growing_(false) {
+    for (int i = 0; i < kMaxLevels; i++) {
+        levels_[i].store(nullptr, std::memory_order_relaxed);
+    }
+    for (int i = 0; i < kCounterStripes; i++) {
+        counters_[i].value.store(0, std::memory_order_relaxed);
+    }
+    growTo(0);
+}
+
+DoubleShowIndex::~DoubleShowIndex() {
+    for (int i = 0; i < kMaxLevels; i++) {
+        delete levels_[i].load(std::memory_order_relaxed);
+    }
+}
+
+DoubleShowIndex::Level *DoubleShowIndex::levelAt(int idx) const {
+    return levels_[idx].load(std::memory_order_acquire);
+}
+
+// Her seviye bir oncekinin dort kati. Yeni seviyeyi tek bir thread ayirir;
+// digerleri mevcut seviyelere eklemeye devam eder, yalnizca tum pencereleri
+// dolu olan ekleme bekler.
+DoubleShowIndex::Level *DoubleShowIndex::growTo(int idx) {
+    if (idx >= kMaxLevels) {
+        throw std::runtime_error("DoubleShowIndex: maximum level count reached");
+    }
+    while (true) {
+        Level *lv = levelAt(idx);
+        if (lv) return lv;
+        bool expected = false;
+        if (growing_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            lv = levelAt(idx);
+            if (!lv) {
+                size_t cap = baseCapacity_ << (2 * idx);
+                lv = new Level;
+                lv->mask = cap - 1;
+                lv->slots.reset(new Slot[cap]);
+                for (size_t i = 0; i < cap; i++) {
+                    lv->slots[i].hi.store(0, std::memory_order_relaxed);
+                    lv->slots[i].lo.store(0, std::memory_order_relaxed);
+                }
+                levels_[idx].store(lv, std::memory_order_release);
+            }
+            growing_.store(false, std::memory_order_release);
+            return lv;
+        }
+        std::this_thread::yield();
+    }
+}
+
+void DoubleShowIndex::countInsert() {
+    static std::atomic<unsigned> nextStripe(0);
+    thread_local unsigned stripe = nextStripe.fetch_add(1, std::memory_order_relaxed) % kCounterStripes;
+    counters_[stripe].value.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool DoubleShowIndex::insertIfAbsent(const ShowTag &tag) {
+    for (int l = 0; l < kMaxLevels; l++) {
+        Level *lv = levelAt(l);
+        if (!lv) lv = growTo(l);
+        size_t start = tag.hi;
+        for (size_t p = 0; p < kProbeWindow; p++) {
+            Slot &slot = lv->slots[(start + p) & lv->mask];
+            uint64_t cur = slot.hi.load(std::memory_order_acquire);
+            if (cur == 0) {
+                if (slot.hi.compare_exchange_strong(cur, tag.hi, std::memory_order_acq_rel)) {
+                    slot.lo.store(tag.lo, std::memory_order_release);
+                    countInsert();
+                    // Son seviyede uzun probe -> bir sonraki seviyeyi simdiden hazirla
+                    if (p >= kProbeWindow / 2 && l + 1 < kMaxLevels && !levelAt(l + 1)
+                        && size() * 2 > capacity()) {
+                        growTo(l + 1);
+                    }
+                    return true;
+                }
+            }
+            if (cur == tag.hi) {
+                uint64_t lo;
+                while ((lo = slot.lo.load(std::memory_order_acquire)) == 0) {
+                    cpuRelax();
+                }
+                if (lo == tag.lo) return false;
+            }
+        }
+    }
+    throw std::runtime_error("DoubleShowIndex: table exhausted");
+}
+
+bool DoubleShowIndex::contains(const ShowTag &tag) const {
+    for (int l = 0; l < kMaxLevels; l++) {
+        Level *lv = levelAt(l);
+        if (!lv) return false;
+        size_t start = tag.hi;
+        for (size_t p = 0; p < kProbeWindow; p++) {
+            const Slot &slot = lv->slots[(start + p) & lv->mask];
+            uint64_t cur = slot.hi.load(std::memory_order_acquire);
+            if (cur == 0) return false;
+            if (cur == tag.hi) {
+                uint64_t lo;
+                while ((lo = slot.lo.load(std::memory_order_acquire)) == 0) {
+                    cpuRelax();
+                }
+                if (lo == tag.lo) return true;
+            }
+        }
+    }
+    return false;
+}
+
+size_t DoubleShowIndex::size() const {
+    size_t total = 0;
+    for (int i = 0; i < kCounterStripes; i++) {
+        total += counters_[i].value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+size_t DoubleShowIndex::capacity() const {
+    size_t total = 0;
+    for (int l = 0; l < kMaxLevels; l++) {
+        Level *lv = levelAt(l);
+        if (!lv) break;
+        total += lv->mask + 1;
+    }
+    return total;
+}
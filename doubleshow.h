@@ -0,0 +1,70 @@
+#ifndef DOUBLESHOW_H
+#define DOUBLESHOW_H
+
+#include "setup.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// 128-bit show etiketi: SHA-512(com || h_agg) ilk 16 byte.
+// hi ve lo sifir olamaz; sifir bos slot / yayinlanmamis slot anlamina gelir.
+struct ShowTag {
+    uint64_t hi;
+    uint64_t lo;
+};
+
+ShowTag computeShowTag(element_t com, element_t h_agg);
+
+// Ayni kimlik bilgisinin iki kez gosterilmesini reddeden lock-free kume.
+// Open addressing, sinirli probe penceresi; bir anahtar pencerede bos slot
+// bulunan ilk seviyeye yazilir. Slotlar hic bosalmadigi icin bu kural
+// eszamanli eklemelerde de tekilligi korur. Dolan seviyelerin ardina dort kat
+// buyuklukte yeni seviye eklenerek tablo durdurulmadan buyur.
+//
+// Kullanim: com ve h_agg acik degerler oldugundan etiket dogrulamadan once
+// alinirsa sahte bir gosterim gercegini kilitler. Pairing oncesi ucuz on
+// eleme contains() ile yapilir; insertIfAbsent() yalnizca tam dogrulanan
+// gosterim icin cagrilir ve yarisi kaybeden ikinci gosterim sayilir.
+class DoubleShowIndex {
+public:
+    explicit DoubleShowIndex(size_t expectedEntries = (1u << 20));
+    ~DoubleShowIndex();
+
+    DoubleShowIndex(const DoubleShowIndex &) = delete;
+    DoubleShowIndex &operator=(const DoubleShowIndex &) = delete;
+
+    // Etiket yeni ise ekler ve true doner; daha once gorulduyse false.
+    bool insertIfAbsent(const ShowTag &tag);
+    bool contains(const ShowTag &tag) const;
+    size_t size() const;
+    size_t capacity() const;
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> hi;
+        std::atomic<uint64_t> lo;
+    };
+    struct Level {
+        size_t mask;
+        std::unique_ptr<Slot[]> slots;
+    };
+    struct alignas(64) CounterStripe {
+        std::atomic<size_t> value;
+    };
+
+    static constexpr int kMaxLevels = 24;
+    static constexpr size_t kProbeWindow = 32;
+    static constexpr int kCounterStripes = 64;
+
+    Level *levelAt(int idx) const;
+    Level *growTo(int idx);
+    void countInsert();
+
+    size_t baseCapacity_;
+    std::atomic<Level*> levels_[kMaxLevels];
+    std::atomic<bool> growing_;
+    CounterStripe counters_[kCounterStripes];
+};
+
+#endif
@@ -0,0 +1,311 @@
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <sys/epoll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "setup.h"
+#include "keygen.h"
+#include "didgen.h"
+#include "prepareblindsign.h"
+#include "blindsign.h"
+#include "unblindsign.h"
+#include "keyfile.h"
+#include "wire.h"
+#include "udsconn.h"
+#include "rng.h"
+using Clock = std::chrono::steady_clock;
+
+// eadaemon icin yuk ureteci.
+//   eaClient provision : parametre ve anahtarlari uretip keydir'e yazar
+//   eaClient           : kapali dongu yuk testi; ayni anda client_inflight
+//                        secmen, her biri rastgele t EA'ya istek gonderir
+
+static double percentile(const std::vector<double> &sorted, double q) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t idx = (size_t)(q * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+static uint32_t frameU32(const unsigned char *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+struct VoterState {
+    Clock::time_point sent;
+    int outstanding = 0;
+    bool failed = false;
+};
+
+int main(int argc, char **argv) {
+    int ne = 0;
+    int t = 0;
+    int voterCount = 0;
+    bool hasSeed = false;
+    uint64_t seed = 0;
+    std::string keyDir = "keys";
+    std::string socketDir = "/tmp";
+    int window = 64;
+    int validateCount = 100;
+    {
+        std::ifstream infile("params.txt");
+        if (!infile) {
+            std::cerr << "Error: params.txt acilamadi!\n";
+            return 1;
+        }
+        std::string line;
+        while (std::getline(infile, line)) {
+            if (line.rfind("ea=", 0) == 0)
+                ne = std::stoi(line.substr(3));
+            else if (line.rfind("threshold=", 0) == 0)
+                t = std::stoi(line.substr(10));
+            else if (line.rfind("votercount=", 0) == 0)
+                voterCount = std::stoi(line.substr(11));
+            else if (line.rfind("seed=", 0) == 0) {
+                seed = std::stoull(line.substr(5));
+                hasSeed = true;
+            }
+            else if (line.rfind("keydir=", 0) == 0)
+                keyDir = line.substr(7);
+            else if (line.rfind("socketdir=", 0) == 0)
+                socketDir = line.substr(10);
+            else if (line.rfind("client_inflight=", 0) == 0)
+                window = std::stoi(line.substr(16));
+            else if (line.rfind("client_validate=", 0) == 0)
+                validateCount = std::stoi(line.substr(16));
+        }
+        infile.close();
+    }
+    if (hasSeed) {
+        installDeterministicRandom(seed);
+    } else {
+        installThreadRandom();
+    }
+
+    if (argc > 1 && std::string(argv[1]) == "provision") {
+        TIACParams params = setupParams();
+        ParamsGuard paramsGuard{params};
+        KeyGenOutput keyOut = keygen(params, t, ne);
+        mkdir(keyDir.c_str(), 0700);
+        writeKeyFiles(keyDir, params, keyOut);
+        std::cout << ne << " EA anahtari " << keyDir << "/ altina yazildi (esik " << t << ")\n";
+        return 0;
+    }
+
+    TIACParams params = setupParamsFromText(readPublicParamText(keyDir));
+    ParamsGuard paramsGuard{params};
+    KeyGenOutput keys;
+    loadPublicKeys(keyDir, params, keys);
+    ne = (int)keys.eaKeys.size();
+    if (t <= 0 || t > ne) {
+        std::cerr << "Error: threshold " << t << " gecersiz (ea=" << ne << ")\n";
+        return 1;
+    }
+    if (window <= 0) {
+        window = 1;
+    }
+    validateCount = std::max(0, std::min(validateCount, voterCount));
+    WireCodec codec = makeWireCodec(params);
+    const size_t requestSize = wireFrameSize(codec, WireType::PrepareRequest);
+    const size_t okSize = wireFrameSize(codec, WireType::BlindSignature);
+    const size_t errSize = wireFrameSize(codec, WireType::SignError);
+
+    // Istekler olcumden once hazirlanip bir kez kodlanir; dogrulanacak
+    // ornek secmenlerin prepare ciktisi unblindSign icin saklanir.
+    auto prepStart = Clock::now();
+    std::vector<unsigned char> frames((size_t)voterCount * requestSize);
+    std::vector<PrepareBlindSignOutput> samplePrep(validateCount);
+    {
+        std::mt19937_64 gen(randomU64());
+        std::uniform_int_distribution<unsigned long long> dist(10000000000ULL, 99999999999ULL);
+        for (int i = 0; i < voterCount; i++) {
+            DID did = createDID(params, std::to_string(dist(gen)));
+            PrepareBlindSignOutput prep = prepareBlindSign(params, did.did);
+            encodePrepareRequest(codec, i, prep, frames.data() + (size_t)i * requestSize);
+            if (i < validateCount) {
+                samplePrep[i] = std::move(prep);
+            }
+        }
+    }
+    auto prepEnd = Clock::now();
+
+    std::vector<UdsConnection> conns(ne);
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    for (int m = 0; m < ne; m++) {
+        conns[m].fd = connectUnix(socketDir + "/ea" + std::to_string(m) + ".sock");
+        setNonBlocking(conns[m].fd);
+        epoll_event e{};
+        e.events = EPOLLIN;
+        e.data.u32 = (uint32_t)m;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, conns[m].fd, &e);
+    }
+    auto updateEvents = [&](int m) {
+        epoll_event e{};
+        e.events = EPOLLIN | (conns[m].wantWrite ? (uint32_t)EPOLLOUT : 0u);
+        e.data.u32 = (uint32_t)m;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, conns[m].fd, &e);
+    };
+    auto flushConn = [&](int m) {
+        bool all = flushPending(conns[m]);
+        if (all == conns[m].wantWrite) {
+            conns[m].wantWrite = !all;
+            updateEvents(m);
+        }
+    };
+
+    std::vector<VoterState> voters(voterCount);
+    std::vector<std::vector<std::vector<unsigned char>>> sampleReplies(validateCount);
+    std::vector<double> latencies;
+    latencies.reserve(voterCount);
+    std::vector<int> adminIndices(ne);
+    std::iota(adminIndices.begin(), adminIndices.end(), 0);
+    std::mt19937 rng(randomU64());
+    int nextVoter = 0, active = 0, completed = 0, failedVoters = 0;
+    long long signatures = 0, signErrors = 0;
+
+    auto finishVoter = [&](int v) {
+        VoterState &s = voters[v];
+        if (s.failed) {
+            failedVoters++;
+        } else {
+            latencies.push_back(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - s.sent).count() / 1000.0);
+        }
+        active--;
+        completed++;
+    };
+    auto onReply = [&](const unsigned char *f, size_t len) {
+        int v;
+        if (len == okSize) {
+            v = (int)frameU32(f + kWireHeaderBytes + 4);
+        } else if (len == errSize) {
+            v = (int)frameU32(f + kWireHeaderBytes);
+        } else {
+            throw std::runtime_error("eaClient: unexpected reply size " + std::to_string(len));
+        }
+        if (v < 0 || v >= voterCount || voters[v].outstanding == 0) {
+            throw std::runtime_error("eaClient: reply for unknown voter " + std::to_string(v));
+        }
+        if (len == okSize) {
+            signatures++;
+            if (v < validateCount) {
+                sampleReplies[v].emplace_back(f, f + len);
+            }
+        } else {
+            signErrors++;
+            voters[v].failed = true;
+        }
+        if (--voters[v].outstanding == 0) {
+            finishVoter(v);
+        }
+    };
+
+    std::vector<epoll_event> events(64);
+    auto loadStart = Clock::now();
+    while (completed < voterCount) {
+        while (active < window && nextVoter < voterCount) {
+            int v = nextVoter++;
+            std::shuffle(adminIndices.begin(), adminIndices.end(), rng);
+            const unsigned char *f = frames.data() + (size_t)v * requestSize;
+            voters[v].sent = Clock::now();
+            voters[v].outstanding = t;
+            for (int j = 0; j < t; j++) {
+                UdsConnection &c = conns[adminIndices[j]];
+                c.out.insert(c.out.end(), f, f + requestSize);
+            }
+            active++;
+        }
+        for (int m = 0; m < ne; m++) {
+            if (!conns[m].out.empty() && !conns[m].wantWrite) {
+                flushConn(m);
+            }
+        }
+        int n = epoll_wait(epollFd, events.data(), (int)events.size(), 10000);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("epoll_wait failed");
+        }
+        if (n == 0) {
+            std::cerr << "Error: EA'lar 10 s boyunca yanit vermedi (" << completed << "/" << voterCount << ")\n";
+            return 1;
+        }
+        for (int i = 0; i < n; i++) {
+            int m = (int)events[i].data.u32;
+            UdsConnection &c = conns[m];
+            if (events[i].events & EPOLLOUT) {
+                flushConn(m);
+            }
+            if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                bool open = readAvailable(c);
+                WireType type;
+                size_t frameLen;
+                while (peekWireFrame(c.in.data() + c.inPos, c.in.size() - c.inPos, type, frameLen)
+                       && c.in.size() - c.inPos >= frameLen) {
+                    onReply(c.in.data() + c.inPos, frameLen);
+                    c.inPos += frameLen;
+                }
+                compactInput(c);
+                if (!open) {
+                    std::cerr << "Error: EA " << m << " baglantiyi kapatti\n";
+                    return 1;
+                }
+            }
+        }
+    }
+    auto loadEnd = Clock::now();
+    for (UdsConnection &c : conns) {
+        close(c.fd);
+    }
+    close(epollFd);
+
+    // Ornek secmenlerin imzalari istemci tarafinda acilip dogrulanir
+    int validated = 0, invalid = 0;
+    BlindSignature sig;
+    initBlindSignature(params, sig);
+    for (int v = 0; v < validateCount; v++) {
+        for (const auto &f : sampleReplies[v]) {
+            try {
+                decodeBlindSignature(codec, f.data(), f.size(), sig);
+                if (sig.voterId != v || sig.adminId < 0 || sig.adminId >= ne) {
+                    throw std::runtime_error("eaClient: reply header mismatch");
+                }
+                unblindSign(params, samplePrep[v], sig, keys.eaKeys[sig.adminId]);
+                validated++;
+            } catch (const std::exception &) {
+                invalid++;
+            }
+        }
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    double prep_ms = std::chrono::duration_cast<std::chrono::microseconds>(prepEnd - prepStart).count() / 1000.0;
+    double load_ms = std::chrono::duration_cast<std::chrono::microseconds>(loadEnd - loadStart).count() / 1000.0;
+    double load_s = load_ms / 1000.0;
+
+    std::cout << "=== EA Yuk Testi ===\n";
+    std::cout << "EA / Esik / Secmen : " << ne << " / " << t << " / " << voterCount << "\n";
+    std::cout << "Inflight penceresi : " << window << "\n";
+    std::cout << "Istek hazirlama    : " << prep_ms << " ms\n";
+    std::cout << "Yuk suresi         : " << load_ms << " ms\n";
+    std::cout << "Throughput         : " << (load_s > 0 ? (voterCount - failedVoters) / load_s : 0.0) << " secmen/s\n";
+    std::cout << "Imza / s           : " << (load_s > 0 ? signatures / load_s : 0.0) << "\n";
+    std::cout << "Latency p50        : " << percentile(latencies, 0.50) << " ms\n";
+    std::cout << "Latency p90        : " << percentile(latencies, 0.90) << " ms\n";
+    std::cout << "Latency p99        : " << percentile(latencies, 0.99) << " ms\n";
+    std::cout << "Latency p99.9      : " << percentile(latencies, 0.999) << " ms\n";
+    std::cout << "Latency max        : " << (latencies.empty() ? 0.0 : latencies.back()) << " ms\n";
+    std::cout << "Reddedilen imza    : " << signErrors << " (" << failedVoters << " secmen)\n";
+    std::cout << "Dogrulanan imza    : " << validated << " gecerli, " << invalid << " gecersiz\n";
+    std::cout << "\n=== Program Sonu ===\n";
+    return invalid == 0 && signErrors == 0 ? 0 : 2;
+}
@@ -0,0 +1,493 @@
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "setup.h"
+#include "keygen.h"
+#include "blindsign.h"
+#include "hashtog1.h"
+#include "keyfile.h"
+#include "wire.h"
+#include "udsconn.h"
+#include "metrics.h"
+#include "rng.h"
+using Clock = std::chrono::steady_clock;
+
+// Tek EA icin imzalayici: epoll ile Unix soketinden PrepareRequest cerceveleri
+// okunur, boyut ya da sure dolunca micro-batch olarak is parcaciklarina
+// verilir; KoR kontrolu ve imza iscilerde yapilir, yanitlar eventfd ile
+// ana donguye doner. Bekleyen istek sayisi ea_queue'ya ulasinca soketlerden
+// okuma durdurulur (geri basinc).
+
+namespace {
+
+volatile sig_atomic_t stopRequested = 0;
+
+void onSignal(int) {
+    stopRequested = 1;
+}
+
+const uint64_t kListenId = 0;
+const uint64_t kEventId = 1;
+
+struct Job {
+    uint64_t connId;
+    std::vector<unsigned char> frame;
+};
+
+struct Reply {
+    uint64_t connId;
+    std::vector<unsigned char> frame;
+};
+
+struct SignerShared {
+    TIACParams &params;
+    const WireCodec &codec;
+    int adminId;
+    const EAKey &key;
+    int eventFd;
+
+    std::mutex batchMutex;
+    std::condition_variable batchReady;
+    std::deque<std::vector<Job>> batches;
+    bool stopping = false;
+
+    std::mutex replyMutex;
+    std::vector<Reply> replies;
+
+    MetricCounter &signedTotal;
+    MetricCounter &rejectedTotal;
+    MetricHistogram &signSeconds;
+
+    SignerShared(TIACParams &p, const WireCodec &c, int a, const EAKey &k)
+        : params(p), codec(c), adminId(a), key(k), eventFd(-1),
+          signedTotal(metricCounter("evoting_ea_signed_total", "Imzalanan istekler", {{"admin", std::to_string(a)}})),
+          rejectedTotal(metricCounter("evoting_ea_rejected_total", "Reddedilen istekler (KoR/hash/cozme)", {{"admin", std::to_string(a)}})),
+          signSeconds(metricHistogram("evoting_ea_sign_seconds", "Istek basina cozme + KoR + imza suresi", {{"admin", std::to_string(a)}})) {}
+};
+
+void workerLoop(SignerShared &shared) {
+    // Cozme hedefleri is parcacigi basina bir kez init edilir, batch
+    // buyudukce eklenir
+    std::deque<PrepareBlindSignOutput> preps;
+    std::deque<Element> hashes;
+    const size_t okSize = wireFrameSize(shared.codec, WireType::BlindSignature);
+    const size_t errSize = wireFrameSize(shared.codec, WireType::SignError);
+    while (true) {
+        std::vector<Job> batch;
+        {
+            std::unique_lock<std::mutex> lock(shared.batchMutex);
+            shared.batchReady.wait(lock, [&] { return shared.stopping || !shared.batches.empty(); });
+            if (shared.batches.empty()) {
+                return;
+            }
+            batch = std::move(shared.batches.front());
+            shared.batches.pop_front();
+        }
+        while (preps.size() < batch.size()) {
+            preps.emplace_back();
+            initPrepareRequest(shared.params, preps.back());
+            hashes.emplace_back(shared.params.pairing, Group::G1);
+        }
+        const size_t n = batch.size();
+        std::vector<int> voterIds(n, -1);
+        std::vector<char> decoded(n, 0);
+        std::vector<uint64_t> elapsedNs(n, 0);
+        std::vector<element_s*> comis, hashOuts;
+        for (size_t i = 0; i < n; i++) {
+            Clock::time_point start = Clock::now();
+            try {
+                decodePrepareRequest(shared.codec, batch[i].frame.data(), batch[i].frame.size(), voterIds[i], preps[i]);
+                decoded[i] = 1;
+                comis.push_back(preps[i].comi);
+                hashOuts.push_back(hashes[i]);
+            } catch (const std::exception &) {
+            }
+            elapsedNs[i] += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+        }
+        // Hash(comi) kontrolleri batch icin bir arada; sure isteklere bolunur
+        if (!comis.empty()) {
+            Clock::time_point start = Clock::now();
+            hashToG1Batch(shared.params, hashOuts.data(), comis.data(), comis.size());
+            uint64_t share = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count() / comis.size();
+            for (size_t i = 0; i < n; i++) {
+                if (decoded[i]) {
+                    elapsedNs[i] += share;
+                }
+            }
+        }
+        std::vector<Reply> out;
+        out.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+            Reply reply{batch[i].connId, {}};
+            Clock::time_point start = Clock::now();
+            try {
+                if (!decoded[i]) {
+                    throw std::runtime_error("eaDaemon: undecodable request");
+                }
+                BlindSignature sig = blindSign(shared.params, preps[i], shared.key.sgk1, shared.key.sgk2, shared.adminId, voterIds[i], hashes[i]);
+                reply.frame.resize(okSize);
+                encodeBlindSignature(shared.codec, sig, reply.frame.data());
+                shared.signedTotal.inc();
+            } catch (const std::exception &) {
+                reply.frame.resize(errSize);
+                encodeSignError(shared.codec, voterIds[i], reply.frame.data());
+                shared.rejectedTotal.inc();
+            }
+            elapsedNs[i] += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+            shared.signSeconds.observeNs(elapsedNs[i]);
+            out.push_back(std::move(reply));
+        }
+        {
+            std::lock_guard<std::mutex> lock(shared.replyMutex);
+            for (Reply &r : out) {
+                shared.replies.push_back(std::move(r));
+            }
+        }
+        uint64_t one = 1;
+        ssize_t w = write(shared.eventFd, &one, sizeof(one));
+        (void)w;
+    }
+}
+
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        std::cerr << "Kullanim: " << argv[0] << " <adminId>\n";
+        return 1;
+    }
+    int adminId = std::stoi(argv[1]);
+    std::string keyDir = "keys";
+    std::string socketDir = "/tmp";
+    int batchMax = 16;
+    long batchWait_us = 200;
+    int workers = (int)std::thread::hardware_concurrency();
+    size_t maxQueue = 4096;
+    int metricsPort = 0;
+    {
+        std::ifstream infile("params.txt");
+        if (!infile) {
+            std::cerr << "Error: params.txt acilamadi!\n";
+            return 1;
+        }
+        std::string line;
+        while (std::getline(infile, line)) {
+            if (line.rfind("keydir=", 0) == 0)
+                keyDir = line.substr(7);
+            else if (line.rfind("socketdir=", 0) == 0)
+                socketDir = line.substr(10);
+            else if (line.rfind("ea_batch=", 0) == 0)
+                batchMax = std::stoi(line.substr(9));
+            else if (line.rfind("ea_batch_wait_us=", 0) == 0)
+                batchWait_us = std::stol(line.substr(17));
+            else if (line.rfind("ea_workers=", 0) == 0)
+                workers = std::stoi(line.substr(11));
+            else if (line.rfind("ea_queue=", 0) == 0)
+                maxQueue = (size_t)std::stoul(line.substr(9));
+            else if (line.rfind("metrics_port=", 0) == 0)
+                metricsPort = std::stoi(line.substr(13));
+        }
+        infile.close();
+    }
+    if (workers <= 0) {
+        workers = 1;
+    }
+    if (batchMax <= 0) {
+        batchMax = 1;
+    }
+
+    installThreadRandom();
+    TIACParams params = setupParamsFromText(readPublicParamText(keyDir));
+    ParamsGuard paramsGuard{params};
+    KeyGenOutput keys;
+    loadPublicKeys(keyDir, params, keys);
+    if (adminId < 0 || adminId >= (int)keys.eaKeys.size()) {
+        std::cerr << "Error: adminId " << adminId << " gecersiz (ea=" << keys.eaKeys.size() << ")\n";
+        return 1;
+    }
+    loadSecretKey(keyDir, adminId, params, keys.eaKeys[adminId]);
+    WireCodec codec = makeWireCodec(params);
+    const size_t requestSize = wireFrameSize(codec, WireType::PrepareRequest);
+
+    SignerShared shared(params, codec, adminId, keys.eaKeys[adminId]);
+
+    std::string socketPath = socketDir + "/ea" + std::to_string(adminId) + ".sock";
+    int listenFd = listenUnix(socketPath, 512);
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    shared.eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.u64 = kListenId;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &ev);
+    ev.data.u64 = kEventId;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, shared.eventFd, &ev);
+
+    struct sigaction sa{};
+    sa.sa_handler = onSignal;
+    sigaction(SIGINT, &sa, nullptr);
+    sigaction(SIGTERM, &sa, nullptr);
+
+    // metrics_port=N: 127.0.0.1:N/metrics uzerinden Prometheus metni
+    const MetricLabels adminLabel = {{"admin", std::to_string(adminId)}};
+    MetricGauge &queueDepth = metricGauge("evoting_ea_queue_depth", "Cevap bekleyen istekler", adminLabel);
+    MetricCounter &batchesTotal = metricCounter("evoting_ea_batches_total", "Iscilere verilen micro-batch'ler", adminLabel);
+    MetricCounter &pausesTotal = metricCounter("evoting_ea_backpressure_total", "Kuyruk dolunca okumanin durduruldugu anlar", adminLabel);
+    MetricGauge &connections = metricGauge("evoting_ea_connections", "Acik istemci baglantilari", adminLabel);
+    std::unique_ptr<MetricsServer> metricsServer;
+    if (metricsPort > 0) {
+        metricsServer.reset(new MetricsServer(metricsPort));
+    }
+
+    std::vector<std::thread> pool;
+    for (int i = 0; i < workers; i++) {
+        pool.emplace_back(workerLoop, std::ref(shared));
+    }
+
+    std::unordered_map<uint64_t, UdsConnection> conns;
+    uint64_t nextConnId = 2;
+    std::vector<Job> pending;
+    Clock::time_point batchDeadline;
+    size_t inflight = 0;
+    bool paused = false;
+    long long requests = 0, rejected = 0, batchCount = 0, pausedTimes = 0;
+    size_t maxInflight = 0;
+
+    auto updateEvents = [&](uint64_t id, UdsConnection &c) {
+        epoll_event e{};
+        e.events = (paused ? 0u : (uint32_t)EPOLLIN) | (c.wantWrite ? (uint32_t)EPOLLOUT : 0u);
+        e.data.u64 = id;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, c.fd, &e);
+    };
+    auto closeConn = [&](uint64_t id) {
+        auto it = conns.find(id);
+        if (it != conns.end()) {
+            epoll_ctl(epollFd, EPOLL_CTL_DEL, it->second.fd, nullptr);
+            close(it->second.fd);
+            conns.erase(it);
+            connections.set((int64_t)conns.size());
+        }
+    };
+    auto dispatch = [&]() {
+        if (pending.empty()) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(shared.batchMutex);
+            shared.batches.push_back(std::move(pending));
+        }
+        shared.batchReady.notify_one();
+        pending.clear();
+        batchCount++;
+        batchesTotal.inc();
+    };
+    auto setPaused = [&](bool p) {
+        if (paused == p) {
+            return;
+        }
+        paused = p;
+        if (p) {
+            pausedTimes++;
+            pausesTotal.inc();
+        }
+        for (auto &kv : conns) {
+            updateEvents(kv.first, kv.second);
+        }
+    };
+    // Tampondaki tam cerceveleri ise donusturur; geri basinc varsa durur.
+    // Protokol hatasinda false doner.
+    auto parseFrames = [&](uint64_t id, UdsConnection &c) {
+        WireType type;
+        size_t frameLen;
+        while (!paused && peekWireFrame(c.in.data() + c.inPos, c.in.size() - c.inPos, type, frameLen)) {
+            if (type != WireType::PrepareRequest || frameLen != requestSize) {
+                return false;
+            }
+            if (c.in.size() - c.inPos < frameLen) {
+                break;
+            }
+            if (pending.empty()) {
+                batchDeadline = Clock::now() + std::chrono::microseconds(batchWait_us);
+            }
+            const unsigned char *f = c.in.data() + c.inPos;
+            pending.push_back(Job{id, std::vector<unsigned char>(f, f + frameLen)});
+            c.inPos += frameLen;
+            requests++;
+            inflight++;
+            queueDepth.set((int64_t)inflight);
+            maxInflight = std::max(maxInflight, inflight);
+            if ((int)pending.size() >= batchMax) {
+                dispatch();
+            }
+            if (inflight >= maxQueue) {
+                setPaused(true);
+            }
+        }
+        compactInput(c);
+        return true;
+    };
+
+    std::cout << "EA " << adminId << " dinliyor: " << socketPath << " (batch " << batchMax << ", "
+              << batchWait_us << " us, " << workers << " isci, kuyruk " << maxQueue << ")\n";
+    if (metricsServer) {
+        std::cout << "Metrikler          : http://127.0.0.1:" << metricsPort << "/metrics\n";
+    }
+
+    std::vector<epoll_event> events(128);
+    while (!stopRequested) {
+        int timeout = -1;
+        if (!pending.empty()) {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(batchDeadline - Clock::now()).count();
+            timeout = left < 0 ? 0 : (int)left + 1;
+        }
+        int n = epoll_wait(epollFd, events.data(), (int)events.size(), timeout);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("epoll_wait failed");
+        }
+        for (int i = 0; i < n; i++) {
+            uint64_t id = events[i].data.u64;
+            uint32_t flags = events[i].events;
+            if (id == kListenId) {
+                while (true) {
+                    int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                    if (fd < 0) {
+                        break;
+                    }
+                    uint64_t cid = nextConnId++;
+                    UdsConnection &c = conns[cid];
+                    c.fd = fd;
+                    epoll_event e{};
+                    e.events = paused ? 0u : (uint32_t)EPOLLIN;
+                    e.data.u64 = cid;
+                    epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &e);
+                    connections.set((int64_t)conns.size());
+                }
+                continue;
+            }
+            if (id == kEventId) {
+                uint64_t counter;
+                ssize_t r = read(shared.eventFd, &counter, sizeof(counter));
+                (void)r;
+                std::vector<Reply> done;
+                {
+                    std::lock_guard<std::mutex> lock(shared.replyMutex);
+                    done.swap(shared.replies);
+                }
+                queueDepth.add(-(int64_t)done.size());
+                for (Reply &reply : done) {
+                    inflight--;
+                    if (reply.frame.size() == wireFrameSize(codec, WireType::SignError)) {
+                        rejected++;
+                    }
+                    auto it = conns.find(reply.connId);
+                    if (it == conns.end()) {
+                        continue;
+                    }
+                    UdsConnection &c = it->second;
+                    c.out.insert(c.out.end(), reply.frame.begin(), reply.frame.end());
+                }
+                for (auto it = conns.begin(); it != conns.end();) {
+                    UdsConnection &c = it->second;
+                    uint64_t cid = it->first;
+                    ++it;
+                    if (c.out.empty()) {
+                        continue;
+                    }
+                    try {
+                        bool all = flushPending(c);
+                        if (all == c.wantWrite) {
+                            c.wantWrite = !all;
+                            updateEvents(cid, c);
+                        }
+                    } catch (const std::exception &) {
+                        closeConn(cid);
+                    }
+                }
+                if (paused && inflight <= maxQueue / 2) {
+                    setPaused(false);
+                    for (auto it = conns.begin(); it != conns.end();) {
+                        uint64_t cid = it->first;
+                        UdsConnection &c = it->second;
+                        ++it;
+                        if (!parseFrames(cid, c)) {
+                            closeConn(cid);
+                        }
+                    }
+                }
+                continue;
+            }
+            auto it = conns.find(id);
+            if (it == conns.end()) {
+                continue;
+            }
+            UdsConnection &c = it->second;
+            if (flags & EPOLLOUT) {
+                try {
+                    if (flushPending(c)) {
+                        c.wantWrite = false;
+                        updateEvents(id, c);
+                    }
+                } catch (const std::exception &) {
+                    closeConn(id);
+                    continue;
+                }
+            }
+            if (flags & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                bool open = readAvailable(c);
+                bool ok = parseFrames(id, c);
+                if (!open || !ok) {
+                    closeConn(id);
+                }
+            }
+        }
+        if (!pending.empty() && Clock::now() >= batchDeadline) {
+            dispatch();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(shared.batchMutex);
+        shared.stopping = true;
+    }
+    shared.batchReady.notify_all();
+    for (auto &t : pool) {
+        t.join();
+    }
+    for (auto &kv : conns) {
+        close(kv.second.fd);
+    }
+    close(listenFd);
+    close(shared.eventFd);
+    close(epollFd);
+    unlink(socketPath.c_str());
+
+    std::cout << "\n=== EA " << adminId << " Ozet ===\n";
+    std::cout << "Istek              : " << requests << "\n";
+    std::cout << "Reddedilen         : " << rejected << "\n";
+    std::cout << "Batch              : " << batchCount;
+    if (batchCount > 0) {
+        std::cout << " (ortalama " << (double)requests / batchCount << " istek)";
+    }
+    std::cout << "\n";
+    std::cout << "En fazla bekleyen  : " << maxInflight << "\n";
+    std::cout << "Geri basinc        : " << pausedTimes << " kez\n";
+    return 0;
+}
@@ -0,0 +1,243 @@
+#include "hashmany.h"
+#include <openssl/sha.h>
+#include "opcount.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+
+namespace {
+
+const uint64_t kK[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+
+const uint64_t kIV[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+};
+
+// GCC vektor uzantisi: islemler cagiran fonksiyonun hedefinde (avx2 /
+// avx512f) derlenir, ayri intrinsic yazimi gerekmez.
+typedef uint64_t V4 __attribute__((vector_size(32)));
+typedef uint64_t V8 __attribute__((vector_size(64)));
+
+// Dolgulu mesajin blok sayisi: veri + 0x80 + 128 bit uzunluk
+size_t blockCount(size_t len) {
+    return (len + 17 + 127) / 128;
+}
+
+// Mesajin b. dolgulu blogu
+void paddedBlock(const HashMessage &m, size_t nb, size_t b, unsigned char *out) {
+    size_t off = b * 128;
+    size_t take = m.len > off ? std::min<size_t>(128, m.len - off) : 0;
+    if (take == 128) {
+        std::memcpy(out, m.data + off, 128);
+        return;
+    }
+    std::memset(out, 0, 128);
+    if (take > 0) {
+        std::memcpy(out, m.data + off, take);
+    }
+    if (m.len >= off && m.len < off + 128) {
+        out[m.len - off] = 0x80;
+    }
+    if (b == nb - 1) {
+        uint64_t bits = (uint64_t)m.len * 8;
+        for (int i = 0; i < 8; i++) {
+            out[127 - i] = (unsigned char)(bits >> (8 * i));
+        }
+    }
+}
+
+uint64_t loadBe64(const unsigned char *p) {
+    uint64_t v;
+    std::memcpy(&v, p, 8);
+    return __builtin_bswap64(v);
+}
+
+// Makro: vektor donduren yardimci fonksiyon -Wpsabi uyarisi uretir
+#define HASHMANY_ROTR(x, n) (((x) >> (n)) | ((x) << (64 - (n))))
+
+// N seridin her biri icin bir blok: state[j] j. durum kelimesinin serit
+// vektoru, w[t][serit] blogun t. kelimesi.
+template <typename V, int N>
+inline __attribute__((always_inline)) void compressLanes(V *state, const uint64_t (*w)[N]) {
+    V W[16];
+    for (int t = 0; t < 16; t++) {
+        std::memcpy(&W[t], w[t], sizeof(V));
+    }
+    V a = state[0], b = state[1], c = state[2], d = state[3];
+    V e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int t = 0; t < 80; t++) {
+        V wt;
+        if (t < 16) {
+            wt = W[t];
+        } else {
+            V w15 = W[(t - 15) & 15], w2 = W[(t - 2) & 15];
+            V s0 = HASHMANY_ROTR(w15, 1) ^ HASHMANY_ROTR(w15, 8) ^ (w15 >> 7);
+            V s1 = HASHMANY_ROTR(w2, 19) ^ HASHMANY_ROTR(w2, 61) ^ (w2 >> 6);
+            wt = W[t & 15] = W[t & 15] + s0 + W[(t - 7) & 15] + s1;
+        }
+        V S1 = HASHMANY_ROTR(e, 14) ^ HASHMANY_ROTR(e, 18) ^ HASHMANY_ROTR(e, 41);
+        V ch = (e & f) ^ (~e & g);
+        V t1 = h + S1 + ch + kK[t] + wt;
+        V S0 = HASHMANY_ROTR(a, 28) ^ HASHMANY_ROTR(a, 34) ^ HASHMANY_ROTR(a, 39);
+        V maj = (a & b) ^ (a & c) ^ (b & c);
+        V t2 = S0 + maj;
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+// N mesaj, hepsi nb bloklu
+template <typename V, int N>
+inline __attribute__((always_inline)) void hashLanes(const HashMessage *const *lanes, size_t nb, unsigned char *const *outs) {
+    V state[8];
+    for (int j = 0; j < 8; j++) {
+        state[j] = V{} + kIV[j];
+    }
+    alignas(64) uint64_t w[16][N];
+    unsigned char block[128];
+    for (size_t b = 0; b < nb; b++) {
+        for (int l = 0; l < N; l++) {
+            paddedBlock(*lanes[l], nb, b, block);
+            for (int t = 0; t < 16; t++) {
+                w[t][l] = loadBe64(block + 8 * t);
+            }
+        }
+        compressLanes<V, N>(state, w);
+    }
+    alignas(64) uint64_t st[8][N];
+    std::memcpy(st, state, sizeof(st));
+    for (int l = 0; l < N; l++) {
+        for (int j = 0; j < 8; j++) {
+            uint64_t v = __builtin_bswap64(st[j][l]);
+            std::memcpy(outs[l] + 8 * j, &v, 8);
+        }
+    }
+}
+
+__attribute__((target("avx512f")))
+void hashLanes8(const HashMessage *const *lanes, size_t nb, unsigned char *const *outs) {
+    hashLanes<V8, 8>(lanes, nb, outs);
+}
+
+__attribute__((target("avx2")))
+void hashLanes4(const HashMessage *const *lanes, size_t nb, unsigned char *const *outs) {
+    hashLanes<V4, 4>(lanes, nb, outs);
+}
+
+int laneCount() {
+    static const int lanes = __builtin_cpu_supports("avx512f") ? 8 : __builtin_cpu_supports("avx2") ? 4 : 1;
+    return lanes;
+}
+
+}
+
+void hashMany(const HashMessage *msgs, size_t count, unsigned char *digests) {
+    const int lanes = laneCount();
+    if (lanes == 1 || count < 2) {
+        for (size_t i = 0; i < count; i++) {
+            SHA512(msgs[i].data, msgs[i].len, digests + i * SHA512_DIGEST_LENGTH);
+        }
+        return;
+    }
+    // Ayni blok sayisindaki mesajlar ardisik olsun diye siralanir
+    std::vector<size_t> blocks(count), order(count);
+    for (size_t i = 0; i < count; i++) {
+        blocks[i] = blockCount(msgs[i].len);
+    }
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t x, size_t y) { return blocks[x] < blocks[y]; });
+
+    const HashMessage *lanePtr[8];
+    unsigned char *outPtr[8];
+    unsigned char unused[8][SHA512_DIGEST_LENGTH];
+    size_t i = 0;
+    while (i < count) {
+        size_t nb = blocks[order[i]];
+        size_t end = i;
+        while (end < count && blocks[order[end]] == nb) {
+            end++;
+        }
+        for (size_t g = i; g < end; g += lanes) {
+            size_t n = std::min<size_t>(lanes, end - g);
+            if (n == 1) {
+                const HashMessage &m = msgs[order[g]];
+                SHA512(m.data, m.len, digests + order[g] * SHA512_DIGEST_LENGTH);
+                continue;
+            }
+            // Bos seritler ilk mesaji tekrar eder, sonuclari atilir
+            for (int l = 0; l < lanes; l++) {
+                if ((size_t)l < n) {
+                    lanePtr[l] = &msgs[order[g + l]];
+                    outPtr[l] = digests + order[g + l] * SHA512_DIGEST_LENGTH;
+                } else {
+                    lanePtr[l] = lanePtr[0];
+                    outPtr[l] = unused[l];
+                }
+            }
+            // OpenSSL yolu SHA512 makrosuyla sayilir; seritler burada
+#ifdef EVOTING_OPCOUNT
+            opCountsLocal().sha512 += n;
+            for (size_t l = 0; l < n; l++) {
+                opCountsLocal().sha512Bytes += lanePtr[l]->len;
+            }
+#endif
+            if (lanes == 8) {
+                hashLanes8(lanePtr, nb, outPtr);
+            } else {
+                hashLanes4(lanePtr, nb, outPtr);
+            }
+        }
+        i = end;
+    }
+}
+
+void hashMany(const std::vector<std::string> &msgs, unsigned char *digests) {
+    std::vector<HashMessage> views(msgs.size());
+    for (size_t i = 0; i < msgs.size(); i++) {
+        views[i].data = reinterpret_cast<const unsigned char*>(msgs[i].data());
+        views[i].len = msgs[i].size();
+    }
+    hashMany(views.data(), views.size(), digests);
+}
+
+const char *hashManyEngine() {
+    switch (laneCount()) {
+        case 8:
+            return "avx512x8";
+        case 4:
+            return "avx2x4";
+        default:
+            return "scalar";
+    }
+}
@@ -0,0 +1,26 @@
+#ifndef HASHMANY_H
+#define HASHMANY_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Cok tamponlu SHA-512: birbirinden bagimsiz mesajlar SIMD seritlerine
+// dagitilir (AVX-512 ile 8, AVX2 ile 4 serit; motor calisma aninda CPU'ya
+// gore secilir, derleme bayragi gerekmez). Ayni blok sayisina sahip mesajlar
+// birlikte islenir; tek kalan mesajlar OpenSSL SHA512'den gecer. Cikti tek
+// seferlik SHA512 ile bit bit aynidir.
+
+struct HashMessage {
+    const unsigned char *data;
+    size_t len;
+};
+
+// digests[i * 64, (i + 1) * 64) = SHA512(msgs[i])
+void hashMany(const HashMessage *msgs, size_t count, unsigned char *digests);
+void hashMany(const std::vector<std::string> &msgs, unsigned char *digests);
+
+// "avx512x8", "avx2x4" ya da "scalar"
+const char *hashManyEngine();
+
+#endif
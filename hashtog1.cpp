@@ -0,0 +1,403 @@
+#include "hashtog1.h"
+#include "hashmany.h"
+#include <openssl/sha.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char kDomain[] = "evoting-hashToG1";
+
+// SHA-512 girdisi: sayac || alan etiketi || veri. Iki ozet (1024 bit) mod q
+// alininca sapma ihmal edilebilir olur.
+std::string expandInput(unsigned char counter, const unsigned char *data, size_t len) {
+    std::string msg;
+    msg.reserve(1 + sizeof(kDomain) + len);
+    msg.push_back((char)counter);
+    msg.append(kDomain, sizeof(kDomain));
+    msg.append(reinterpret_cast<const char*>(data), len);
+    return msg;
+}
+
+// q en fazla 1024 bit
+const size_t kMaxLimbs = 16;
+
+// Montgomery bicimli alan elemani: a * 2^(64n) mod q, n = q'nun limb sayisi
+struct Fe {
+    mp_limb_t v[kMaxLimbs];
+};
+
+struct JacobianPoint {
+    Fe X, Y, Z;   // Z == 0: sonsuzdaki nokta
+};
+
+// y^2 = x^3 + x uzerinde mpn duzeyinde Montgomery aritmetigi. mpz_mul +
+// mpz_mod bolme yaptigindan carpma basina ~3 kat daha pahali.
+class CurveMath {
+public:
+    explicit CurveMath(TIACParams &params) : h_(params.cofactor) {
+        mpz_srcptr q = params.field_order;
+        if (mpz_fdiv_ui(q, 4) != 3) {
+            throw std::runtime_error("hashToG1: field order must be 3 mod 4");
+        }
+        n_ = mpz_size(q);
+        if (n_ > kMaxLimbs) {
+            throw std::runtime_error("hashToG1: field order too large");
+        }
+        mpz_init_set(q_, q);
+        mpz_init(e_);
+        mpz_add_ui(e_, q_, 1);
+        mpz_fdiv_q_2exp(e_, e_, 2);
+        mpz_init(tmp_);
+        limbsOf(qLimbs_, q_);
+        // qInv_ = -q^-1 mod 2^64 (Newton; q tek)
+        mp_limb_t inv = 1;
+        for (int i = 0; i < 7; i++) {
+            inv *= 2 - qLimbs_[0] * inv;
+        }
+        qInv_ = -inv;
+        // 3h ile h'nin bitleri farki h'nin NAF basamaklarini verir
+        mpz_init(h3_);
+        mpz_mul_ui(h3_, h_, 3);
+        toMont(one_, 1);
+    }
+    ~CurveMath() {
+        mpz_clear(q_);
+        mpz_clear(e_);
+        mpz_clear(tmp_);
+        mpz_clear(h3_);
+    }
+    CurveMath(const CurveMath &) = delete;
+    CurveMath &operator=(const CurveMath &) = delete;
+
+    // digest: 128 bayt; (x, y) Montgomery bicimli egri noktasi
+    void mapToCurve(Fe &x, Fe &y, const unsigned char *digest) {
+        Mpz u, f, s;
+        mpz_import(u, 2 * SHA512_DIGEST_LENGTH, 1, 1, 0, 0, digest);
+        mpz_mod(u, u, q_);
+        // f = u^3 + u
+        mpz_mul(f, u, u);
+        mpz_add_ui(f, f, 1);
+        mpz_mul(f, f, u);
+        mpz_mod(f, f, q_);
+        // f kare degilse s^2 = -f = (-u)^3 + (-u)
+        mpz_powm(s, f, e_, q_);
+        mpz_mul(tmp_, s, s);
+        mpz_mod(tmp_, tmp_, q_);
+        bool square = mpz_cmp(tmp_, f) == 0;
+        // Kok isaretten bagimsiz (cift) secilir, sonra u'nun paritesi
+        // uygulanir: u ve -u ayni x'in iki farkli noktasina gider
+        bool negate = mpz_odd_p(s.get()) != mpz_odd_p(u.get());
+        if (!square) {
+            mpz_sub(u, q_, u);
+            mpz_mod(u, u, q_);
+        }
+        if (negate && mpz_sgn(s.get()) != 0) {
+            mpz_sub(s, q_, s);
+        }
+        toMont(x, u);
+        toMont(y, s);
+    }
+
+    // R = h * (x, y), NAF ile; eksi adimlar -P'yi ekler
+    void clearCofactor(JacobianPoint &R, const Fe &x, const Fe &y) {
+        Fe negY;
+        sub(negY, zero(), y);
+        size_t top = mpz_sizeinbase(h3_, 2);
+        setInfinity(R);
+        for (size_t i = top; i-- > 1;) {
+            dbl(R);
+            int digit = mpz_tstbit(h3_, i) - mpz_tstbit(h_, i);
+            if (digit > 0) {
+                addAffine(R, x, y);
+            } else if (digit < 0) {
+                addAffine(R, x, negY);
+            }
+        }
+    }
+
+    bool isInfinity(const JacobianPoint &P) const {
+        return isZero(P.Z);
+    }
+
+    // Afin donusum icin Z'lerin tersleri, tek mpz_invert (Montgomery hilesi)
+    void invertZ(const std::vector<JacobianPoint> &pts, std::vector<Fe> &inv) {
+        std::vector<size_t> live;
+        for (size_t i = 0; i < pts.size(); i++) {
+            if (!isInfinity(pts[i])) {
+                live.push_back(i);
+            }
+        }
+        if (live.empty()) {
+            return;
+        }
+        // inv[live[j]] = Z_0 * ... * Z_j
+        inv[live[0]] = pts[live[0]].Z;
+        for (size_t j = 1; j < live.size(); j++) {
+            mul(inv[live[j]], inv[live[j - 1]], pts[live[j]].Z);
+        }
+        Fe acc;
+        fromMont(tmp_, inv[live.back()]);
+        if (mpz_invert(tmp_, tmp_, q_) == 0) {
+            throw std::runtime_error("hashToG1: Z not invertible");
+        }
+        toMont(acc, tmp_);
+        for (size_t j = live.size(); j-- > 1;) {
+            mul(inv[live[j]], acc, inv[live[j - 1]]);
+            mul(acc, acc, pts[live[j]].Z);
+        }
+        inv[live[0]] = acc;
+    }
+
+    // x = X / Z^2, y = Y / Z^3, duz (Montgomery disi) bicimde
+    void toAffine(mpz_t x, mpz_t y, const JacobianPoint &P, const Fe &zInv) {
+        Fe zi2, t;
+        mul(zi2, zInv, zInv);
+        mul(t, P.X, zi2);
+        fromMont(x, t);
+        mul(zi2, zi2, zInv);
+        mul(t, P.Y, zi2);
+        fromMont(y, t);
+    }
+
+private:
+    void limbsOf(mp_limb_t *out, mpz_srcptr v) const {
+        size_t used = mpz_size(v);
+        const mp_limb_t *src = mpz_limbs_read(v);
+        for (size_t i = 0; i < n_; i++) {
+            out[i] = i < used ? src[i] : 0;
+        }
+    }
+
+    void toMont(Fe &out, mpz_srcptr v) {
+        mpz_mul_2exp(tmp_, v, 64 * n_);
+        mpz_mod(tmp_, tmp_, q_);
+        limbsOf(out.v, tmp_);
+    }
+
+    void toMont(Fe &out, unsigned long v) {
+        mpz_set_ui(tmp_, v);
+        toMont(out, tmp_);
+    }
+
+    void fromMont(mpz_t out, const Fe &a) {
+        Fe plain, unit{};
+        unit.v[0] = 1;
+        mul(plain, a, unit);
+        mpz_import(out, n_, -1, sizeof(mp_limb_t), 0, 0, plain.v);
+    }
+
+    const Fe &zero() const {
+        static const Fe z{};
+        return z;
+    }
+
+    bool isZero(const Fe &a) const {
+        for (size_t i = 0; i < n_; i++) {
+            if (a.v[i] != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // r = a * b * 2^(-64n) mod q; REDC tasimalari c[] icinde ertelenir
+    void mul(Fe &r, const Fe &a, const Fe &b) const {
+        mp_limb_t t[2 * kMaxLimbs], c[kMaxLimbs];
+        if (&a == &b) {
+            mpn_sqr(t, a.v, n_);
+        } else {
+            mpn_mul_n(t, a.v, b.v, n_);
+        }
+        for (size_t i = 0; i < n_; i++) {
+            c[i] = mpn_addmul_1(t + i, qLimbs_, n_, t[i] * qInv_);
+        }
+        mp_limb_t carry = mpn_add_n(r.v, t + n_, c, n_);
+        if (carry || mpn_cmp(r.v, qLimbs_, n_) >= 0) {
+            mpn_sub_n(r.v, r.v, qLimbs_, n_);
+        }
+    }
+
+    void add(Fe &r, const Fe &a, const Fe &b) const {
+        mp_limb_t carry = mpn_add_n(r.v, a.v, b.v, n_);
+        if (carry || mpn_cmp(r.v, qLimbs_, n_) >= 0) {
+            mpn_sub_n(r.v, r.v, qLimbs_, n_);
+        }
+    }
+
+    void sub(Fe &r, const Fe &a, const Fe &b) const {
+        if (mpn_sub_n(r.v, a.v, b.v, n_)) {
+            mpn_add_n(r.v, r.v, qLimbs_, n_);
+        }
+    }
+
+    void setInfinity(JacobianPoint &P) const {
+        P.X = one_;
+        P.Y = one_;
+        P.Z = zero();
+    }
+
+    // a = 1 icin Jacobian ikileme
+    void dbl(JacobianPoint &P) const {
+        if (isInfinity(P)) {
+            return;
+        }
+        Fe yy, s, m, zz, t;
+        mul(yy, P.Y, P.Y);
+        // S = 4 X YY
+        mul(s, P.X, yy);
+        add(s, s, s);
+        add(s, s, s);
+        // M = 3 XX + ZZ^2
+        mul(zz, P.Z, P.Z);
+        mul(zz, zz, zz);
+        mul(m, P.X, P.X);
+        add(t, m, m);
+        add(m, m, t);
+        add(m, m, zz);
+        // Z3 = 2 Y Z
+        mul(P.Z, P.Y, P.Z);
+        add(P.Z, P.Z, P.Z);
+        // X3 = M^2 - 2S
+        mul(P.X, m, m);
+        sub(P.X, P.X, s);
+        sub(P.X, P.X, s);
+        // Y3 = M (S - X3) - 8 YY^2
+        sub(s, s, P.X);
+        mul(P.Y, m, s);
+        mul(yy, yy, yy);
+        add(yy, yy, yy);
+        add(yy, yy, yy);
+        add(yy, yy, yy);
+        sub(P.Y, P.Y, yy);
+    }
+
+    // P += (x, y), karisik toplama
+    void addAffine(JacobianPoint &P, const Fe &x, const Fe &y) const {
+        if (isInfinity(P)) {
+            P.X = x;
+            P.Y = y;
+            P.Z = one_;
+            return;
+        }
+        Fe z1z1, hh, r, v, hhh;
+        mul(z1z1, P.Z, P.Z);
+        // H = x Z1Z1 - X1
+        mul(hh, x, z1z1);
+        sub(hh, hh, P.X);
+        // R = y Z1 Z1Z1 - Y1
+        mul(r, y, P.Z);
+        mul(r, r, z1z1);
+        sub(r, r, P.Y);
+        if (isZero(hh)) {
+            if (isZero(r)) {
+                dbl(P);
+            } else {
+                P.Z = zero();
+            }
+            return;
+        }
+        // Z3 = Z1 H
+        mul(P.Z, P.Z, hh);
+        // HHH = H^3, V = X1 H^2
+        mul(hhh, hh, hh);
+        mul(v, P.X, hhh);
+        mul(hhh, hhh, hh);
+        // X3 = R^2 - HHH - 2V
+        mul(P.X, r, r);
+        sub(P.X, P.X, hhh);
+        sub(P.X, P.X, v);
+        sub(P.X, P.X, v);
+        // Y3 = R (V - X3) - Y1 HHH
+        sub(v, v, P.X);
+        mul(v, r, v);
+        mul(hhh, P.Y, hhh);
+        sub(P.Y, v, hhh);
+    }
+
+    mpz_srcptr h_;
+    mpz_t q_;
+    mpz_t e_;    // (q + 1) / 4
+    mpz_t h3_;
+    mpz_t tmp_;
+    size_t n_;
+    mp_limb_t qLimbs_[kMaxLimbs];
+    mp_limb_t qInv_;
+    Fe one_;
+};
+
+void exportFixed(unsigned char *out, size_t width, mpz_srcptr v) {
+    size_t n = (mpz_sizeinbase(v, 2) + 7) / 8;
+    std::fill(out, out + width, 0);
+    if (mpz_sgn(v) != 0) {
+        mpz_export(out + width - n, nullptr, 1, 1, 0, 0, v);
+    }
+}
+
+// digests[i * 128, (i + 1) * 128): i. girdinin iki ozeti
+void digestsToG1(TIACParams &params, element_s *const *outs, const unsigned char *digests, size_t count) {
+    CurveMath curve(params);
+    std::vector<JacobianPoint> pts(count);
+    for (size_t i = 0; i < count; i++) {
+        Fe x, y;
+        curve.mapToCurve(x, y, digests + i * 2 * SHA512_DIGEST_LENGTH);
+        curve.clearCofactor(pts[i], x, y);
+    }
+    std::vector<Fe> inv(count);
+    curve.invertZ(pts, inv);
+
+    const size_t width = (size_t)pairing_length_in_bytes_G1(params.pairing) / 2;
+    std::vector<unsigned char> buf(2 * width);
+    Mpz x, y;
+    for (size_t i = 0; i < count; i++) {
+#ifdef EVOTING_OPCOUNT
+        opCountHash(outs[i]);
+#endif
+        if (curve.isInfinity(pts[i])) {
+            element_set0(outs[i]);
+            continue;
+        }
+        curve.toAffine(x, y, pts[i], inv[i]);
+        exportFixed(buf.data(), width, x);
+        exportFixed(buf.data() + width, width, y);
+        element_from_bytes(outs[i], buf.data());
+    }
+}
+
+}
+
+void hashToG1(TIACParams &params, element_t out, const unsigned char *data, size_t len) {
+    unsigned char digests[2 * SHA512_DIGEST_LENGTH];
+    for (unsigned char k = 0; k < 2; k++) {
+        std::string msg = expandInput(k, data, len);
+        SHA512(reinterpret_cast<const unsigned char*>(msg.data()), msg.size(), digests + k * SHA512_DIGEST_LENGTH);
+    }
+    element_s *outs[1] = {out};
+    digestsToG1(params, outs, digests, 1);
+}
+
+void hashToG1(TIACParams &params, element_t out, element_t in) {
+    std::vector<unsigned char> bytes((size_t)element_length_in_bytes(in));
+    element_to_bytes(bytes.data(), in);
+    hashToG1(params, out, bytes.data(), bytes.size());
+}
+
+void hashToG1Batch(TIACParams &params, element_s *const *outs, element_s *const *ins, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    std::vector<std::string> msgs;
+    msgs.reserve(2 * count);
+    std::vector<unsigned char> bytes;
+    for (size_t i = 0; i < count; i++) {
+        bytes.resize((size_t)element_length_in_bytes(ins[i]));
+        element_to_bytes(bytes.data(), ins[i]);
+        msgs.push_back(expandInput(0, bytes.data(), bytes.size()));
+        msgs.push_back(expandInput(1, bytes.data(), bytes.size()));
+    }
+    std::vector<unsigned char> digests(msgs.size() * SHA512_DIGEST_LENGTH);
+    hashMany(msgs, digests.data());
+    digestsToG1(params, outs, digests.data(), count);
+}
@@ -0,0 +1,24 @@
+#ifndef HASHTOG1_H
+#define HASHTOG1_H
+
+#include "setup.h"
+#include <cstddef>
+
+// Tip A egri y^2 = x^3 + x (q = 3 mod 4) icin deterministik hash-to-G1.
+// u = SHA-512 genisletmesi mod q; f(x) = x^3 + x tek oldugundan ve -1 kare
+// olmadigindan f(u) ve f(-u)'dan tam biri karedir, tek s = f(u)^((q+1)/4)
+// her iki durumda da y'yi verir (deneme-artirma dongusu yok). Nokta
+// Jacobian koordinatlarda h ile carpilarak G1'e indirilir; yalnizca son
+// afin donusum bir ters alma ister. PBC'nin element_from_hash'inden farkli
+// noktalar uretir: ayni protokoldeki tum taraflar bu fonksiyonu kullanmali.
+
+void hashToG1(TIACParams &params, element_t out, const unsigned char *data, size_t len);
+
+// Girdi: in'in element_to_bytes ikili kodlamasi
+void hashToG1(TIACParams &params, element_t out, element_t in);
+
+// outs[i] = hashToG1(ins[i]); SHA-512'ler hashMany ile, afin donusum
+// ters almalari Montgomery hilesiyle tek mpz_invert'te paylasilir
+void hashToG1Batch(TIACParams &params, element_s *const *outs, element_s *const *ins, size_t count);
+
+#endif
@@ -0,0 +1,158 @@
+#include "keyfile.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+static const char kPublicMagic[8] = {'E', 'V', 'P', 'U', 'B', 'K', '0', '1'};
+static const char kSecretMagic[8] = {'E', 'V', 'E', 'A', 'K', 'E', 'Y', '1'};
+
+static void putU32(std::vector<unsigned char> &out, uint32_t v) {
+    for (int i = 0; i < 4; i++) {
+        out.push_back((unsigned char)(v >> (8 * i)));
+    }
+}
+
+static void putBlob(std::vector<unsigned char> &out, const unsigned char *data, size_t len) {
+    putU32(out, (uint32_t)len);
+    out.insert(out.end(), data, data + len);
+}
+
+static void putElement(std::vector<unsigned char> &out, element_s *e) {
+    std::vector<unsigned char> buf(element_length_in_bytes(e));
+    element_to_bytes(buf.data(), e);
+    putBlob(out, buf.data(), buf.size());
+}
+
+// Skalerler dosyada Zr elemani olarak tutulur (bicim degismez)
+static void putScalar(std::vector<unsigned char> &out, TIACParams &params, const Scalar &v) {
+    Element zr(params.pairing, Group::Zr);
+    scalarToElement(zr, v);
+    putElement(out, zr);
+}
+
+static void writeFile(const std::string &path, const std::vector<unsigned char> &data) {
+    std::ofstream f(path, std::ios::binary | std::ios::trunc);
+    if (!f) {
+        throw std::runtime_error("writeKeyFiles: cannot write " + path);
+    }
+    f.write((const char*)data.data(), data.size());
+}
+
+// Uzunluk onekli alanlari sirayla okuyan imlec
+struct KeyReader {
+    std::vector<unsigned char> data;
+    size_t pos = 0;
+    std::string path;
+
+    KeyReader(const std::string &p, const char magic[8]) : path(p) {
+        std::ifstream f(path, std::ios::binary);
+        if (!f) {
+            throw std::runtime_error("key file not found: " + path);
+        }
+        data.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+        if (data.size() < 8 || !std::equal(magic, magic + 8, data.begin())) {
+            throw std::runtime_error("not a key file: " + path);
+        }
+        pos = 8;
+    }
+    uint32_t u32() {
+        if (pos + 4 > data.size()) {
+            throw std::runtime_error("truncated key file: " + path);
+        }
+        uint32_t v = (uint32_t)data[pos] | ((uint32_t)data[pos + 1] << 8) | ((uint32_t)data[pos + 2] << 16) | ((uint32_t)data[pos + 3] << 24);
+        pos += 4;
+        return v;
+    }
+    const unsigned char *blob(size_t &len) {
+        len = u32();
+        if (pos + len > data.size()) {
+            throw std::runtime_error("truncated key file: " + path);
+        }
+        const unsigned char *p = data.data() + pos;
+        pos += len;
+        return p;
+    }
+    void element(element_s *e) {
+        size_t len;
+        const unsigned char *p = blob(len);
+        if ((size_t)element_length_in_bytes(e) != len) {
+            throw std::runtime_error("key file element width mismatch: " + path);
+        }
+        element_from_bytes(e, const_cast<unsigned char*>(p));
+    }
+    void scalar(TIACParams &params, Scalar &v) {
+        Element zr(params.pairing, Group::Zr);
+        element(zr);
+        scalarFromElement(v, zr);
+    }
+};
+
+void writeKeyFiles(const std::string &dir, TIACParams &params, const KeyGenOutput &keyOut) {
+    std::vector<unsigned char> pub(kPublicMagic, kPublicMagic + 8);
+    putBlob(pub, (const unsigned char*)params.paramText.data(), params.paramText.size());
+    putElement(pub, params.g1);
+    putElement(pub, params.g2);
+    putElement(pub, params.h1);
+    putElement(pub, keyOut.mvk.alpha2);
+    putElement(pub, keyOut.mvk.beta2);
+    putElement(pub, keyOut.mvk.beta1);
+    putU32(pub, (uint32_t)keyOut.eaKeys.size());
+    for (const EAKey &k : keyOut.eaKeys) {
+        putElement(pub, k.vkm1);
+        putElement(pub, k.vkm2);
+        putElement(pub, k.vkm3);
+    }
+    writeFile(dir + "/public.key", pub);
+
+    for (size_t m = 0; m < keyOut.eaKeys.size(); m++) {
+        std::vector<unsigned char> sec(kSecretMagic, kSecretMagic + 8);
+        putU32(sec, (uint32_t)m);
+        putScalar(sec, params, keyOut.eaKeys[m].sgk1);
+        putScalar(sec, params, keyOut.eaKeys[m].sgk2);
+        writeFile(dir + "/ea" + std::to_string(m) + ".key", sec);
+    }
+}
+
+std::string readPublicParamText(const std::string &dir) {
+    KeyReader r(dir + "/public.key", kPublicMagic);
+    size_t len;
+    const unsigned char *p = r.blob(len);
+    return std::string((const char*)p, len);
+}
+
+void loadPublicKeys(const std::string &dir, TIACParams &params, KeyGenOutput &keyOut) {
+    KeyReader r(dir + "/public.key", kPublicMagic);
+    size_t len;
+    r.blob(len);
+    r.element(params.g1);
+    r.element(params.g2);
+    r.element(params.h1);
+    keyOut.mvk.alpha2.init(params.pairing, Group::G2);
+    keyOut.mvk.beta2.init(params.pairing, Group::G2);
+    keyOut.mvk.beta1.init(params.pairing, Group::G1);
+    r.element(keyOut.mvk.alpha2);
+    r.element(keyOut.mvk.beta2);
+    r.element(keyOut.mvk.beta1);
+    uint32_t ne = r.u32();
+    keyOut.eaKeys.clear();
+    keyOut.eaKeys.resize(ne);
+    for (EAKey &k : keyOut.eaKeys) {
+        k.vkm1.init(params.pairing, Group::G2);
+        k.vkm2.init(params.pairing, Group::G2);
+        k.vkm3.init(params.pairing, Group::G1);
+        r.element(k.vkm1);
+        r.element(k.vkm2);
+        r.element(k.vkm3);
+    }
+}
+
+void loadSecretKey(const std::string &dir, int adminId, TIACParams &params, EAKey &eaKey) {
+    KeyReader r(dir + "/ea" + std::to_string(adminId) + ".key", kSecretMagic);
+    if ((int)r.u32() != adminId) {
+        throw std::runtime_error("loadSecretKey: admin id mismatch in " + r.path);
+    }
+    r.scalar(params, eaKey.sgk1);
+    r.scalar(params, eaKey.sgk2);
+}
@@ -0,0 +1,24 @@
+#ifndef KEYFILE_H
+#define KEYFILE_H
+
+#include "setup.h"
+#include "keygen.h"
+#include <string>
+
+// Anahtar dagitimi: dir/public.key (pairing parametreleri, g1, g2, h1, ana
+// dogrulama anahtari ve her EA'nin vkm1..3'u) ve her EA icin gizli
+// dir/ea<m>.key (sgk1, sgk2). Imzalayici surecler ve istemciler ayni
+// parametreleri buradan kurar.
+
+void writeKeyFiles(const std::string &dir, TIACParams &params, const KeyGenOutput &keyOut);
+
+std::string readPublicParamText(const std::string &dir);
+
+// params setupParamsFromText(readPublicParamText(dir)) ile kurulmus olmali.
+// keyOut.mvk ve tum EA'larin acik anahtarlari doldurulur; sgk'lar bos kalir.
+void loadPublicKeys(const std::string &dir, TIACParams &params, KeyGenOutput &keyOut);
+
+// dir/ea<adminId>.key'den sgk1, sgk2'yi eaKey'e yukler.
+void loadSecretKey(const std::string &dir, int adminId, TIACParams &params, EAKey &eaKey);
+
+#endif
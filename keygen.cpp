@@ -1,32 +1,17 @@
 #include "keygen.h"
+#include "rng.h"
 #include <iostream>
 #include <vector>
-#include <random>
 #include <stdexcept>
 // TBB header'ını kaldırdık
 
-static void random_mpz_modp(mpz_t rop, const mpz_t p) {
-    static std::random_device rd;
-    static std::mt19937_64 gen(rd());
-    size_t bits = mpz_sizeinbase(p, 2);
-    size_t bytes = (bits + 7) / 8;
-    std::vector<unsigned char> buf(bytes);
-    for (size_t i = 0; i < bytes; i++) {
-        buf[i] = static_cast<unsigned char>(gen() & 0xFF);
-    }
-    mpz_import(rop, bytes, 1, 1, 0, 0, buf.data());
-    mpz_mod(rop, rop, p);
-}
-
-
-static void randomPolynomial(std::vector<mpz_t> &poly, int t, const mpz_t p) {
+static void randomPolynomial(std::vector<Mpz> &poly, int t, const mpz_t p) {
     for (int i = 0; i < t; i++) {
-        mpz_init(poly[i]);
-        random_mpz_modp(poly[i], p);
+        randomMpzModp(poly[i], p);
     }
 }
 
-static void evalPolynomial(mpz_t result, const std::vector<mpz_t> &poly, int xValue, const mpz_t p) {
+static void evalPolynomial(mpz_t result, const std::vector<Mpz> &poly, int xValue, const mpz_t p) {
     mpz_set_ui(result, 0);
     mpz_t term;
     mpz_init(term);
@@ -46,62 +31,32 @@ static void evalPolynomial(mpz_t result, const std::vector<mpz_t> &poly, int xVa
 KeyGenOutput keygen(TIACParams &params, int t, int ne) {
     KeyGenOutput keyOut;
     keyOut.eaKeys.resize(ne);
-    std::vector<mpz_t> vPoly(t), wPoly(t);
+    std::vector<Mpz> vPoly(t), wPoly(t);
     randomPolynomial(vPoly, t, params.prime_order);
     randomPolynomial(wPoly, t, params.prime_order);
-    mpz_t x, y;
-    mpz_init(x);
-    mpz_init(y);
+    Scalar x, y;
     evalPolynomial(x, vPoly, 0, params.prime_order);
     evalPolynomial(y, wPoly, 0, params.prime_order);
-    element_init_G2(keyOut.mvk.alpha2, params.pairing);
-    element_init_G2(keyOut.mvk.beta2,  params.pairing);
-    element_init_G1(keyOut.mvk.beta1,  params.pairing);
-    element_t expX, expY;
-    element_init_Zr(expX, params.pairing);
-    element_init_Zr(expY, params.pairing);
-    element_set_mpz(expX, x);
-    element_set_mpz(expY, y);
-    element_pow_zn(keyOut.mvk.alpha2, params.g2, expX);
-    element_pow_zn(keyOut.mvk.beta2, params.g2, expY);
-    element_pow_zn(keyOut.mvk.beta1, params.g1, expY);
+    keyOut.mvk.alpha2.init(params.pairing, Group::G2);
+    keyOut.mvk.beta2.init(params.pairing, Group::G2);
+    keyOut.mvk.beta1.init(params.pairing, Group::G1);
+    scalarPow(keyOut.mvk.alpha2, params.g2, x);
+    scalarPow(keyOut.mvk.beta2, params.g2, y);
+    scalarPow(keyOut.mvk.beta1, params.g1, y);
     
     // Paralel döngüyü normal for döngüsüyle değiştirdik
     for(int m = 1; m <= ne; m++) {
-        element_init_Zr(keyOut.eaKeys[m - 1].sgk1, params.pairing);
-        element_init_Zr(keyOut.eaKeys[m - 1].sgk2, params.pairing);
-        element_init_G2(keyOut.eaKeys[m - 1].vkm1, params.pairing);
-        element_init_G2(keyOut.eaKeys[m - 1].vkm2, params.pairing);
-        element_init_G1(keyOut.eaKeys[m - 1].vkm3, params.pairing);
+        EAKey &k = keyOut.eaKeys[m - 1];
+        k.vkm1.init(params.pairing, Group::G2);
+        k.vkm2.init(params.pairing, Group::G2);
+        k.vkm3.init(params.pairing, Group::G1);
 
-        mpz_t xm, ym;
-        mpz_init(xm);
-        mpz_init(ym);
-        evalPolynomial(xm, vPoly, m, params.prime_order);
-        evalPolynomial(ym, wPoly, m, params.prime_order);
-        element_set_mpz(keyOut.eaKeys[m - 1].sgk1, xm);
-        element_set_mpz(keyOut.eaKeys[m - 1].sgk2, ym);
-        element_t expXm, expYm;
-        element_init_Zr(expXm, params.pairing);
-        element_init_Zr(expYm, params.pairing);
-        element_set_mpz(expXm, xm);
-        element_set_mpz(expYm, ym);
-        element_pow_zn(keyOut.eaKeys[m - 1].vkm1, params.g2, expXm);
-        element_pow_zn(keyOut.eaKeys[m - 1].vkm2, params.g2, expYm);
-        element_pow_zn(keyOut.eaKeys[m - 1].vkm3, params.g1, expYm);
-        element_clear(expXm);
-        element_clear(expYm);
-        mpz_clear(xm);
-        mpz_clear(ym);
+        evalPolynomial(k.sgk1, vPoly, m, params.prime_order);
+        evalPolynomial(k.sgk2, wPoly, m, params.prime_order);
+        scalarPow(k.vkm1, params.g2, k.sgk1);
+        scalarPow(k.vkm2, params.g2, k.sgk2);
+        scalarPow(k.vkm3, params.g1, k.sgk2);
     }
 
-    for (int i = 0; i < t; i++) {
-        mpz_clear(vPoly[i]);
-        mpz_clear(wPoly[i]);
-    }
-    mpz_clear(x);
-    mpz_clear(y);
-    element_clear(expX);
-    element_clear(expY);
     return keyOut;
 }
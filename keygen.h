@@ -2,21 +2,22 @@
 #define KEYGEN_H
 
 #include "setup.h"
+#include "scalar.h"
 #include <vector>
 
 struct MasterVerKey {
-    element_t alpha2; 
-    element_t beta2;  
-    element_t beta1;  
+    Element alpha2; 
+    Element beta2;  
+    Element beta1;  
 };
 
 
 struct EAKey {
-    element_t sgk1;
-    element_t sgk2;
-    element_t vkm1;
-    element_t vkm2;
-    element_t vkm3;
+    Scalar sgk1;
+    Scalar sgk2;
+    Element vkm1;
+    Element vkm2;
+    Element vkm3;
 };
 
 struct KeyGenOutput {
@@ -1,4 +1,5 @@
 #include "kor.h"
+#include "scratch.h"
 #include <openssl/sha.h>
 #include <sstream>
 #include <iomanip>
@@ -46,16 +47,16 @@ static std::vector<unsigned char> hexToBytes(const std::string& hex) {
     return bytes;
 }
 
-void stringToElement(element_t result, const std::string &str, pairing_t pairing, int element_type) {
+void stringToElement(Element &result, const std::string &str, pairing_t pairing, int element_type) {
     switch (element_type) {
         case 1: 
-            element_init_G1(result, pairing);
+            result.init(pairing, Group::G1);
             break;
         case 2: 
-            element_init_G2(result, pairing);
+            result.init(pairing, Group::G2);
             break;
         default:
-            element_init_Zr(result, pairing);
+            result.init(pairing, Group::Zr);
             break;
     }
     std::vector<unsigned char> bytes = hexToBytes(str);
@@ -67,140 +68,48 @@ void stringToElement(element_t result, const std::string &str, pairing_t pairing
     }
 }
 
-static void copy_const_element(element_t dest, const element_t src, pairing_t pairing, int element_type) {
-    switch (element_type) {
-        case 1: 
-            element_init_G1(dest, pairing);
-            break;
-        case 2: 
-            element_init_G2(dest, pairing);
-            break;
-        default: 
-            element_init_Zr(dest, pairing);
-            break;
-    }
-    element_t temp;
-    temp[0] = *((element_s*)(&src[0]));
-    element_set(dest, temp);
-}
-
-static void copy_const_mpz(mpz_t dest, const mpz_t src) {
-    mpz_init(dest);
-    mpz_set(dest, src);
-}
-
-KnowledgeOfRepProof generateKoRProof(TIACParams &params,const element_t h,const element_t k,const element_t r,const element_t com,const element_t alpha2,const element_t beta2,const mpz_t did_int,const mpz_t o) {    
+KnowledgeOfRepProof generateKoRProof(TIACParams &params,const PrepareBlindSignOutput &prep,const Element &k,const Scalar &r,const Element &alpha2,const Element &beta2) {    
     KnowledgeOfRepProof proof;
-    element_init_Zr(proof.c, params.pairing);
-    element_init_Zr(proof.s1, params.pairing);
-    element_init_Zr(proof.s2, params.pairing);
-    element_init_Zr(proof.s3, params.pairing);
-    element_t h_copy, k_copy, com_copy, alpha2_copy, beta2_copy, r_copy;
-    copy_const_element(h_copy, h, params.pairing, 1);        
-    copy_const_element(k_copy, k, params.pairing, 2);      
-    copy_const_element(com_copy, com, params.pairing, 1);   
-    copy_const_element(alpha2_copy, alpha2, params.pairing, 2); 
-    copy_const_element(beta2_copy, beta2, params.pairing, 2);  
-    copy_const_element(r_copy, r, params.pairing, 0);      
-    mpz_t did_int_copy, o_copy;
-    copy_const_mpz(did_int_copy, did_int);
-    copy_const_mpz(o_copy, o);
-    element_t did_elem, o_elem;
-    element_init_Zr(did_elem, params.pairing);
-    element_init_Zr(o_elem, params.pairing);
-    element_set_mpz(did_elem, did_int_copy);
-    element_set_mpz(o_elem, o_copy);
-    element_t r1, r2, r3;
-    element_init_Zr(r1, params.pairing);
-    element_init_Zr(r2, params.pairing);
-    element_init_Zr(r3, params.pairing);
-    element_random(r1);
-    element_random(r2);
-    element_random(r3);
-    element_t k_prime;
-    element_init_G2(k_prime, params.pairing);
-    element_t g2_r1, beta2_r2;
-    element_init_G2(g2_r1, params.pairing);
-    element_init_G2(beta2_r2, params.pairing);
-    element_pow_zn(g2_r1, params.g2, r1);
-    element_pow_zn(beta2_r2, beta2_copy, r2);
-    element_mul(k_prime, g2_r1, alpha2_copy);
-    element_mul(k_prime, k_prime, beta2_r2);
-    element_t com_prime;
-    element_init_G1(com_prime, params.pairing);
-    element_t g1_r3, h_r2;
-    element_init_G1(g1_r3, params.pairing);
-    element_init_G1(h_r2, params.pairing);
-    element_pow_zn(g1_r3, params.g1, r3);
-    element_pow_zn(h_r2, h_copy, r2);
-    element_mul(com_prime, g1_r3, h_r2);
+    Scalar r1, r2, r3;
+    scalarRandom(r1, params.prime_order);
+    scalarRandom(r2, params.prime_order);
+    scalarRandom(r3, params.prime_order);
+    // k' = alpha2 * g2^r1 * beta2^r2, com' = g1^r3 * h^r2
+    ScratchFrame scratch(params.pairing);
+    element_s *k_prime = scratch.g2();
+    scalarPow2(k_prime, params.g2, r1, beta2, r2);
+    element_mul(k_prime, k_prime, alpha2);
+    element_s *com_prime = scratch.g1();
+    scalarPow2(com_prime, params.g1, r3, prep.h, r2);
     std::ostringstream hashOSS;
     hashOSS << elementToStringG1(params.g1)
             << elementToStringG2(params.g2)
-            << elementToStringG1(h_copy)
-            << elementToStringG1(com_copy)
+            << prep.h_str
+            << prep.com_str
             << elementToStringG1(com_prime)
-            << elementToStringG2(k_copy)
+            << elementToStringG2(k)
             << elementToStringG2(k_prime);
     std::string hashInput = hashOSS.str();
     unsigned char hashDigest[SHA512_DIGEST_LENGTH];
     SHA512(reinterpret_cast<const unsigned char*>(hashInput.data()), hashInput.size(), hashDigest);
-    std::ostringstream hashFinalOSS;
-    hashFinalOSS << std::hex << std::setfill('0');
-    for (int i = 0; i < SHA512_DIGEST_LENGTH; i++) {
-        hashFinalOSS << std::setw(2) << (int)hashDigest[i];
-    }
-    std::string c_str = hashFinalOSS.str();
-    mpz_t c_mpz;
-    mpz_init(c_mpz);
-    if(mpz_set_str(c_mpz, c_str.c_str(), 16) != 0)
-        throw std::runtime_error("generateKoRProof: Error converting hash to mpz");
-    mpz_mod(c_mpz, c_mpz, params.prime_order);
-    element_t c_elem;
-    element_init_Zr(c_elem, params.pairing);
-    element_set_mpz(c_elem, c_mpz);
-    mpz_clear(c_mpz);
-    element_t temp;
-    element_init_Zr(temp, params.pairing);
-    element_mul(temp, c_elem, r_copy);
-    element_sub(proof.s1, r1, temp);
-    element_clear(temp);
-    element_t temp2;
-    element_init_Zr(temp2, params.pairing);
-    element_mul(temp2, c_elem, did_elem);
-    element_sub(proof.s2, r2, temp2);
-    element_clear(temp2);
-    element_t temp3;
-    element_init_Zr(temp3, params.pairing);
-    element_mul(temp3, c_elem, o_elem);
-    element_sub(proof.s3, r3, temp3);
-    element_clear(temp3);
-    element_set(proof.c, c_elem);
+    Scalar c;
+    scalarFromDigest(c, hashDigest, SHA512_DIGEST_LENGTH, params.prime_order);
+    scalarResponse(r1, r1, c, r, params.prime_order);
+    scalarResponse(r2, r2, c, prep.did, params.prime_order);
+    scalarResponse(r3, r3, c, prep.o, params.prime_order);
+    proof.c.init(params.pairing, Group::Zr);
+    proof.s1.init(params.pairing, Group::Zr);
+    proof.s2.init(params.pairing, Group::Zr);
+    proof.s3.init(params.pairing, Group::Zr);
+    scalarToElement(proof.c, c);
+    scalarToElement(proof.s1, r1);
+    scalarToElement(proof.s2, r2);
+    scalarToElement(proof.s3, r3);
     std::ostringstream korOSS;
-    korOSS << elementToStringG1(c_elem) << " "
+    korOSS << elementToStringG1(proof.c) << " "
            << elementToStringG1(proof.s1) << " "
            << elementToStringG1(proof.s2) << " "
            << elementToStringG1(proof.s3);
     proof.proof_string = korOSS.str();
-    element_clear(h_copy);
-    element_clear(k_copy);
-    element_clear(com_copy);
-    element_clear(alpha2_copy);
-    element_clear(beta2_copy);
-    element_clear(r_copy);
-    element_clear(did_elem);
-    element_clear(o_elem);
-    element_clear(r1);
-    element_clear(r2);
-    element_clear(r3);
-    element_clear(k_prime);
-    element_clear(g2_r1);
-    element_clear(beta2_r2);
-    element_clear(com_prime);
-    element_clear(g1_r3);
-    element_clear(h_r2);
-    element_clear(c_elem);
-    mpz_clear(did_int_copy);
-    mpz_clear(o_copy);
     return proof;
-}
\ No newline at end of file
+}
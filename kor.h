@@ -2,29 +2,30 @@
 #define KOR_H
 
 #include "setup.h"
+#include "scalar.h"
+#include "prepareblindsign.h"
 #include <string>
 #include <pbc/pbc.h>
 
 struct KnowledgeOfRepProof {
-    element_t c;   
-    element_t s1;  
-    element_t s2;  
-    element_t s3; 
+    Element c;   
+    Element s1;  
+    Element s2;  
+    Element s3; 
     std::string proof_string; 
 };
 
+// h, com, DID ve o secmenin prepare ciktisindan (onbellekli kodlamalariyla)
+// alinir; aggregate h'si prepare h'si ile aynidir (unblindSign kontrol eder).
 KnowledgeOfRepProof generateKoRProof(
     TIACParams &params,
-    const element_t h,     
-    const element_t k,     
-    const element_t r,     
-    const element_t com,    
-    const element_t alpha2, 
-    const element_t beta2, 
-    const mpz_t did_int,    
-    const mpz_t o          
+    const PrepareBlindSignOutput &prep,
+    const Element &k,
+    const Scalar &r,
+    const Element &alpha2,
+    const Element &beta2
 );
 
-void stringToElement(element_t result, const std::string &str, pairing_t pairing, int element_type);
+void stringToElement(Element &result, const std::string &str, pairing_t pairing, int element_type);
 
 #endif // KOR_H
\ No newline at end of file
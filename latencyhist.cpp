@@ -0,0 +1,167 @@
+#include "latencyhist.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+static const int kLinearBuckets = 128;
+static const int kSubBuckets = 64;
+static const int kBucketCount = kLinearBuckets + 57 * kSubBuckets;
+
+static int bucketIndex(uint64_t v) {
+    if (v < (uint64_t)kLinearBuckets) {
+        return (int)v;
+    }
+    int msb = 63 - __builtin_clzll(v);
+    int shift = msb - 6;
+    int mantissa = (int)(v >> shift);
+    return kLinearBuckets + (shift - 1) * kSubBuckets + (mantissa - kSubBuckets);
+}
+
+static uint64_t bucketUpper(int idx) {
+    if (idx < kLinearBuckets) {
+        return (uint64_t)idx;
+    }
+    int shift = (idx - kLinearBuckets) / kSubBuckets + 1;
+    uint64_t mantissa = (uint64_t)((idx - kLinearBuckets) % kSubBuckets + kSubBuckets);
+    if (shift + 7 >= 64 && mantissa == 127) {
+        return std::numeric_limits<uint64_t>::max();
+    }
+    return ((mantissa + 1) << shift) - 1;
+}
+
+LatencyHistogram::LatencyHistogram() : buckets_(kBucketCount, 0) {
+    reset();
+}
+
+void LatencyHistogram::reset() {
+    std::fill(buckets_.begin(), buckets_.end(), 0);
+    count_ = 0;
+    min_ = std::numeric_limits<uint64_t>::max();
+    max_ = 0;
+    sum_ = 0;
+    sumSq_ = 0;
+}
+
+void LatencyHistogram::record(uint64_t ns) {
+    buckets_[bucketIndex(ns)]++;
+    count_++;
+    min_ = std::min(min_, ns);
+    max_ = std::max(max_, ns);
+    double d = (double)ns;
+    sum_ += d;
+    sumSq_ += d * d;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other) {
+    for (int i = 0; i < kBucketCount; i++) {
+        buckets_[i] += other.buckets_[i];
+    }
+    count_ += other.count_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+    sum_ += other.sum_;
+    sumSq_ += other.sumSq_;
+}
+
+double LatencyHistogram::mean() const {
+    return count_ ? sum_ / count_ : 0.0;
+}
+
+double LatencyHistogram::stddev() const {
+    if (count_ < 2) {
+        return 0.0;
+    }
+    double m = mean();
+    double var = (sumSq_ - count_ * m * m) / (count_ - 1);
+    return var > 0 ? std::sqrt(var) : 0.0;
+}
+
+uint64_t LatencyHistogram::percentile(double q) const {
+    if (count_ == 0) {
+        return 0;
+    }
+    q = std::min(1.0, std::max(0.0, q));
+    uint64_t rank = (uint64_t)std::ceil(q * count_);
+    if (rank == 0) {
+        rank = 1;
+    }
+    uint64_t seen = 0;
+    for (int i = 0; i < kBucketCount; i++) {
+        seen += buckets_[i];
+        if (seen >= rank) {
+            return std::min(bucketUpper(i), max_);
+        }
+    }
+    return max_;
+}
+
+LatencyHistogram &LatencyRecorder::op(const std::string &name) {
+    for (auto &kv : ops) {
+        if (kv.first == name) {
+            return kv.second;
+        }
+    }
+    ops.emplace_back(name, LatencyHistogram());
+    return ops.back().second;
+}
+
+std::string jsonString(const std::string &s) {
+    std::ostringstream out;
+    out << '"';
+    for (unsigned char c : s) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (c < 0x20) {
+            out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int)c << std::dec << std::setfill(' ');
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+    return out.str();
+}
+
+void writeBenchJson(const std::string &path, const BenchReport &report, const LatencyRecorder &recorder) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("writeBenchJson: cannot write " + path);
+    }
+    out << std::fixed << std::setprecision(3);
+    out << "{\n";
+    out << "  \"benchmark\": " << jsonString(report.benchmark) << ",\n";
+    out << "  \"config\": {";
+    for (size_t i = 0; i < report.config.size(); i++) {
+        out << (i ? ", " : "") << jsonString(report.config[i].first) << ": " << report.config[i].second;
+    }
+    out << "},\n";
+    out << "  \"phases_ms\": {";
+    for (size_t i = 0; i < report.phases_ms.size(); i++) {
+        out << (i ? "," : "") << "\n    " << jsonString(report.phases_ms[i].first) << ": " << report.phases_ms[i].second;
+    }
+    out << "\n  },\n";
+    out << "  \"operations_us\": {";
+    for (size_t i = 0; i < recorder.ops.size(); i++) {
+        const LatencyHistogram &h = recorder.ops[i].second;
+        double secs = h.totalSeconds();
+        out << (i ? "," : "") << "\n    " << jsonString(recorder.ops[i].first) << ": {"
+            << "\"count\": " << h.count()
+            << ", \"mean\": " << h.mean() / 1000.0
+            << ", \"stddev\": " << h.stddev() / 1000.0
+            << ", \"min\": " << h.min() / 1000.0
+            << ", \"p50\": " << h.percentile(0.50) / 1000.0
+            << ", \"p90\": " << h.percentile(0.90) / 1000.0
+            << ", \"p99\": " << h.percentile(0.99) / 1000.0
+            << ", \"p999\": " << h.percentile(0.999) / 1000.0
+            << ", \"max\": " << h.max() / 1000.0
+            << ", \"ops_per_s\": " << (secs > 0 ? h.count() / secs : 0.0) << "}";
+    }
+    out << "\n  },\n";
+    out << "  \"voters_per_s\": " << report.voters_per_s << ",\n";
+    out << "  \"total_ms\": " << report.total_ms << ",\n";
+    out << "  \"peak_rss_kb\": " << report.peakRssKb << "\n";
+    out << "}\n";
+}
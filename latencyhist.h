@@ -0,0 +1,82 @@
+#ifndef LATENCYHIST_H
+#define LATENCYHIST_H
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+// HDR tarzi log-lineer gecikme histogrami (nanosaniye). 128'den kucuk
+// degerler tam, daha buyukleri her ikinin kuvveti araliginda 64 alt kovaya
+// bolunur: goreli hata < %1.6, bellek sabit (~30 KB). Ortalama ve varyans
+// kovalardan degil ham toplamlardan hesaplanir. Thread-safe degil; paralel
+// kayitta is parcacigi basina bir histogram tutulup merge edilir.
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    void record(uint64_t ns);
+    void merge(const LatencyHistogram &other);
+    void reset();
+
+    uint64_t count() const { return count_; }
+    uint64_t min() const { return count_ ? min_ : 0; }
+    uint64_t max() const { return max_; }
+    double mean() const;
+    double stddev() const;
+    double totalSeconds() const { return sum_ / 1e9; }
+    // q in [0,1]; kovanin ust siniri (max ile kirpilmis) doner
+    uint64_t percentile(double q) const;
+
+private:
+    std::vector<uint64_t> buckets_;
+    uint64_t count_;
+    uint64_t min_;
+    uint64_t max_;
+    double sum_;
+    double sumSq_;
+};
+
+// Kapsam bitince gecen sureyi histograma yazar.
+class LatencyScope {
+public:
+    explicit LatencyScope(LatencyHistogram &hist) : hist_(hist), start_(std::chrono::steady_clock::now()) {}
+    ~LatencyScope() {
+        hist_.record((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start_).count());
+    }
+
+    LatencyScope(const LatencyScope &) = delete;
+    LatencyScope &operator=(const LatencyScope &) = delete;
+
+private:
+    LatencyHistogram &hist_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// Isimli histogramlar; ekleme sirasi rapor sirasidir. deque: op()'un
+// dondurdugu referanslar sonraki eklemelerde gecerli kalir.
+struct LatencyRecorder {
+    std::deque<std::pair<std::string, LatencyHistogram>> ops;
+
+    LatencyHistogram &op(const std::string &name);
+};
+
+// Benchmark sonucu JSON olarak: config (anahtar -> ham JSON degeri),
+// phases_ms, her islem icin count/mean/stddev/min/p50/p90/p99/p99.9/max (us)
+// ve tek cekirdek throughput'u.
+struct BenchReport {
+    std::string benchmark;
+    std::vector<std::pair<std::string, std::string>> config;
+    std::vector<std::pair<std::string, double>> phases_ms;
+    double total_ms = 0;
+    double voters_per_s = 0;
+    long peakRssKb = 0;
+};
+
+std::string jsonString(const std::string &s);
+void writeBenchJson(const std::string &path, const BenchReport &report, const LatencyRecorder &recorder);
+
+#endif
@@ -0,0 +1,318 @@
+#include "loadgen.h"
+#include "didgen.h"
+#include "voterchain.h"
+#include "latencyhist.h"
+#include "rng.h"
+#include "trace.h"
+#include "metrics.h"
+#include <tbb/task_arena.h>
+#include <tbb/parallel_for.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+using Clock = std::chrono::steady_clock;
+
+struct LoadGenerator::Pool {
+    std::vector<DID> dids;
+    std::vector<std::vector<int>> adminSets;
+    std::vector<IssuedCredential> creds;
+};
+
+namespace {
+
+struct Arrival {
+    double at_s;
+    bool verify;
+};
+
+// Ortalama hizi rate olan gelis anlari, [0, duration) araliginda
+std::vector<Arrival> makeSchedule(const LoadConfig &config, double rate) {
+    std::vector<Arrival> out;
+    std::mt19937_64 gen(randomU64());
+    std::bernoulli_distribution isVerify(std::min(1.0, std::max(0.0, config.verifyRatio)));
+    const double D = config.duration_s;
+    switch (config.arrival) {
+    case ArrivalKind::Constant:
+        for (long k = 0; k / rate < D; k++) {
+            out.push_back({k / rate, false});
+        }
+        break;
+    case ArrivalKind::Poisson: {
+        std::exponential_distribution<double> gap(rate);
+        for (double at = gap(gen); at < D; at += gap(gen)) {
+            out.push_back({at, false});
+        }
+        break;
+    }
+    case ArrivalKind::Burst: {
+        // Acik pencerelerde rate*B hizinda Poisson; kapali zaman atlanir
+        double period = config.burstPeriod_ms / 1000.0;
+        double on = period / std::max(1.0, config.burstFactor);
+        std::exponential_distribution<double> gap(rate * period / on);
+        for (double tau = gap(gen);; tau += gap(gen)) {
+            double at = std::floor(tau / on) * period + std::fmod(tau, on);
+            if (at >= D) {
+                break;
+            }
+            out.push_back({at, false});
+        }
+        break;
+    }
+    case ArrivalKind::Replay: {
+        const std::vector<double> &trace = config.trace_ms;
+        if (trace.size() < 2 || trace.back() <= trace.front()) {
+            throw std::runtime_error("load: replay trace needs at least two increasing timestamps");
+        }
+        double span = (trace.back() - trace.front()) / 1000.0;
+        double traceRate = (trace.size() - 1) / span;
+        double scale = traceRate / rate;
+        for (double base = 0;; base += span * scale) {
+            bool any = false;
+            for (size_t k = 0; k + 1 < trace.size(); k++) {
+                double at = base + (trace[k] - trace.front()) / 1000.0 * scale;
+                if (at >= D) {
+                    break;
+                }
+                out.push_back({at, false});
+                any = true;
+            }
+            if (!any) {
+                break;
+            }
+        }
+        break;
+    }
+    }
+    for (Arrival &a : out) {
+        a.verify = isVerify(gen);
+    }
+    return out;
+}
+
+double ms(uint64_t ns) {
+    return ns / 1e6;
+}
+
+}
+
+ArrivalKind parseArrivalKind(const std::string &name) {
+    if (name == "constant") return ArrivalKind::Constant;
+    if (name == "poisson") return ArrivalKind::Poisson;
+    if (name == "burst") return ArrivalKind::Burst;
+    if (name == "replay") return ArrivalKind::Replay;
+    throw std::runtime_error("unknown load_arrival '" + name + "' (constant|poisson|burst|replay)");
+}
+
+const char *arrivalKindName(ArrivalKind kind) {
+    switch (kind) {
+    case ArrivalKind::Constant: return "constant";
+    case ArrivalKind::Poisson: return "poisson";
+    case ArrivalKind::Burst: return "burst";
+    case ArrivalKind::Replay: return "replay";
+    }
+    return "?";
+}
+
+LoadGenerator::LoadGenerator(TIACParams &params, KeyGenOutput &keyOut, const LoadConfig &config)
+    : params_(params), keyOut_(keyOut), config_(config), pool_(new Pool) {
+    const int ne = (int)keyOut.eaKeys.size();
+    if (config_.t <= 0 || config_.t > ne) {
+        throw std::runtime_error("LoadGenerator: threshold must be in [1, ea]");
+    }
+    if (config_.workers <= 0) {
+        config_.workers = (int)std::thread::hardware_concurrency();
+    }
+    const int n = std::max(1, config_.pool);
+    Pool &pool = *pool_;
+    pool.adminSets.resize(n);
+    std::mt19937_64 gen(randomU64());
+    std::uniform_int_distribution<unsigned long long> dist(10000000000ULL, 99999999999ULL);
+    std::vector<int> adminIndices(ne);
+    std::vector<std::string> userIds(n);
+    for (int i = 0; i < n; i++) {
+        userIds[i] = std::to_string(dist(gen));
+        std::iota(adminIndices.begin(), adminIndices.end(), 0);
+        std::shuffle(adminIndices.begin(), adminIndices.end(), gen);
+        pool.adminSets[i].assign(adminIndices.begin(), adminIndices.begin() + config_.t);
+    }
+    pool.dids = createDIDs(params, userIds);
+    // Dogrulama istekleri onceden ihrac edilmis gosterimleri kullanir
+    if (config_.verifyRatio > 0) {
+        pool.creds.resize(n);
+        tbb::parallel_for(0, n, [&](int i) {
+            RandomStreamScope stream((uint64_t)i);
+            issueCredential(params_, keyOut_, pool.dids[i].did, pool.adminSets[i], i, pool.creds[i], nullptr);
+        });
+    }
+}
+
+LoadGenerator::~LoadGenerator() = default;
+
+LoadTrialReport LoadGenerator::runTrial(double rate) {
+    if (rate <= 0) {
+        throw std::runtime_error("LoadGenerator: rate must be positive");
+    }
+    Pool &pool = *pool_;
+    const int n = (int)pool.dids.size();
+    std::vector<Arrival> schedule = makeSchedule(config_, rate);
+    const long long total = (long long)schedule.size();
+
+    LatencyHistogram service, sojourn;
+    std::mutex histMutex;
+    std::mutex doneMutex;
+    std::condition_variable doneCv;
+    long long done = 0;
+    std::atomic<long long> inflight(0), maxInflight(0), completed(0), failed(0), abandoned(0);
+    std::atomic<bool> abandon(false);
+    std::atomic<long long> lastFinishNs(0);
+    // Her deneme ayri akis araligi kullanir ki tekrarlar ayni rastgeleligi gormesin
+    static std::atomic<uint64_t> streamBase(1ULL << 40);
+    const uint64_t base = streamBase.fetch_add((uint64_t)total + 1);
+
+    // Metrik sunucusu aciksa ayni olaylar canli da izlenebilir
+    MetricCounter *okTotal[2] = {
+        &metricCounter("evoting_load_completed_total", "Tamamlanan istekler", {{"kind", "issue"}}),
+        &metricCounter("evoting_load_completed_total", "Tamamlanan istekler", {{"kind", "verify"}})
+    };
+    MetricCounter *failTotal[2] = {
+        &metricCounter("evoting_load_failed_total", "Basarisiz istekler", {{"kind", "issue"}}),
+        &metricCounter("evoting_load_failed_total", "Basarisiz istekler", {{"kind", "verify"}})
+    };
+    MetricHistogram *sojournSeconds[2] = {
+        &metricHistogram("evoting_load_sojourn_seconds", "Planlanan gelisten tamamlanmaya sure", {{"kind", "issue"}}),
+        &metricHistogram("evoting_load_sojourn_seconds", "Planlanan gelisten tamamlanmaya sure", {{"kind", "verify"}})
+    };
+    MetricGauge &inflightGauge = metricGauge("evoting_load_inflight", "Kuyrukta ya da islenmekte olan istekler");
+    MetricGauge &offeredGauge = metricGauge("evoting_load_offered_rate", "Su anki denemenin sunulan hizi (istek/s)");
+    offeredGauge.set((int64_t)rate);
+
+    tbb::task_arena arena(config_.workers, 0);
+    const Clock::time_point start = Clock::now();
+
+    for (long long k = 0; k < total; k++) {
+        const Arrival a = schedule[k];
+        const Clock::time_point due = start + std::chrono::nanoseconds((long long)(a.at_s * 1e9));
+        std::this_thread::sleep_until(due);
+        long long now = inflight.fetch_add(1, std::memory_order_relaxed) + 1;
+        inflightGauge.add(1);
+        long long seen = maxInflight.load(std::memory_order_relaxed);
+        while (now > seen && !maxInflight.compare_exchange_weak(seen, now, std::memory_order_relaxed)) {
+        }
+        const int p = (int)(k % n);
+        arena.enqueue([&, a, due, p, k] {
+            if (abandon.load(std::memory_order_relaxed)) {
+                abandoned.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                RandomStreamScope stream(base + (uint64_t)k);
+                const Clock::time_point begin = Clock::now();
+                bool ok = false;
+                const int kind = a.verify && !pool.creds.empty() ? 1 : 0;
+                try {
+                    if (kind == 1) {
+                        TRACE_SPAN("verify", p);
+                        ok = verifyCredential(params_, keyOut_, pool.creds[p]);
+                    } else {
+                        IssuedCredential cred;
+                        issueCredential(params_, keyOut_, pool.dids[p].did, pool.adminSets[p], p, cred, nullptr);
+                        ok = true;
+                    }
+                } catch (const std::exception &) {
+                    ok = false;
+                }
+                const Clock::time_point end = Clock::now();
+                {
+                    std::lock_guard<std::mutex> lock(histMutex);
+                    service.record((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+                    sojourn.record((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(end - due).count());
+                }
+                (ok ? completed : failed).fetch_add(1, std::memory_order_relaxed);
+                (ok ? okTotal : failTotal)[kind]->inc();
+                sojournSeconds[kind]->observeNs((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(end - due).count());
+                long long endNs = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+                long long prev = lastFinishNs.load(std::memory_order_relaxed);
+                while (endNs > prev && !lastFinishNs.compare_exchange_weak(prev, endNs, std::memory_order_relaxed)) {
+                }
+            }
+            inflight.fetch_sub(1, std::memory_order_relaxed);
+            inflightGauge.add(-1);
+            std::lock_guard<std::mutex> lock(doneMutex);
+            done++;
+            doneCv.notify_one();
+        });
+    }
+
+    // Bosaltma: en fazla max(5 s, sure) beklenir, sonra kuyruktakiler atlanir
+    {
+        std::unique_lock<std::mutex> lock(doneMutex);
+        auto drainUntil = Clock::now() + std::chrono::milliseconds((long long)(std::max(5.0, config_.duration_s) * 1000));
+        if (!doneCv.wait_until(lock, drainUntil, [&] { return done == total; })) {
+            abandon.store(true);
+            doneCv.wait(lock, [&] { return done == total; });
+        }
+    }
+
+    LoadTrialReport rep;
+    rep.offeredRate = rate;
+    rep.requests = total;
+    rep.completed = completed.load();
+    rep.failed = failed.load();
+    rep.abandoned = abandoned.load();
+    rep.maxInflight = maxInflight.load();
+    double span_s = lastFinishNs.load() / 1e9;
+    rep.achievedRate = span_s > 0 ? rep.completed / span_s : 0.0;
+    rep.serviceP50_ms = ms(service.percentile(0.50));
+    rep.serviceP99_ms = ms(service.percentile(0.99));
+    rep.sojournP50_ms = ms(sojourn.percentile(0.50));
+    rep.sojournP90_ms = ms(sojourn.percentile(0.90));
+    rep.sojournP99_ms = ms(sojourn.percentile(0.99));
+    rep.sojournP999_ms = ms(sojourn.percentile(0.999));
+    rep.sojournMax_ms = ms(sojourn.max());
+    rep.withinSlo = rep.abandoned == 0 && rep.failed == 0 && rep.completed > 0
+        && rep.sojournP99_ms <= config_.slo_ms
+        && rep.achievedRate >= config_.minAchievedRatio * rate;
+    return rep;
+}
+
+SaturationReport LoadGenerator::findSaturation(double startRate) {
+    SaturationReport out;
+    double good = 0, bad = 0;
+    double rate = startRate;
+    // Ilk ihlale kadar buyut (ilk deneme basarisizsa kucult)
+    while ((int)out.trials.size() < config_.maxTrials) {
+        out.trials.push_back(runTrial(rate));
+        if (out.trials.back().withinSlo) {
+            good = rate;
+            if (bad > 0) {
+                break;
+            }
+            rate *= config_.step;
+        } else {
+            bad = rate;
+            if (good > 0) {
+                break;
+            }
+            rate /= config_.step;
+        }
+    }
+    if (good > 0 && bad > 0) {
+        for (int i = 0; i < config_.refineSteps && (int)out.trials.size() < config_.maxTrials; i++) {
+            double mid = (good + bad) / 2;
+            out.trials.push_back(runTrial(mid));
+            if (out.trials.back().withinSlo) {
+                good = mid;
+            } else {
+                bad = mid;
+            }
+        }
+    }
+    out.saturationRate = good;
+    return out;
+}
@@ -0,0 +1,80 @@
+#ifndef LOADGEN_H
+#define LOADGEN_H
+
+#include "setup.h"
+#include "keygen.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+// Acik dongu yuk ureteci: istekler tamamlanmayi beklemeden, yapilandirilan
+// gelis surecine gore TBB isci havuzuna (task_arena::enqueue) birakilir.
+// Servis suresi = isin basindan sonuna; sojourn = planlanan gelis anindan
+// sonuna (dagitici gecikse bile koordineli ihmal olmaz).
+
+enum class ArrivalKind { Constant, Poisson, Burst, Replay };
+
+ArrivalKind parseArrivalKind(const std::string &name);
+const char *arrivalKindName(ArrivalKind kind);
+
+struct LoadConfig {
+    ArrivalKind arrival = ArrivalKind::Poisson;
+    double duration_s = 10.0;
+    double verifyRatio = 0.0;          // dogrulama isteklerinin orani
+    int workers = 0;                    // 0: donanim is parcacigi sayisi
+    int pool = 256;                     // onceden hazirlanan secmen/gosterim sayisi
+    int t = 0;
+    // Burst: her periyodun 1/burstFactor'unde burstFactor x hiz, kalaninda bos
+    double burstFactor = 4.0;
+    double burstPeriod_ms = 1000.0;
+    // Replay: gelis anlari (ms); hiz, iz ortalama hizina gore olceklenir
+    std::vector<double> trace_ms;
+    // Doygunluk aramasi
+    double slo_ms = 1000.0;             // p99 sojourn siniri
+    double minAchievedRatio = 0.95;     // tamamlanan / sunulan alt siniri
+    double step = 1.5;                  // artan adim carpani
+    int refineSteps = 3;                // ikili arama adimi
+    int maxTrials = 20;
+};
+
+struct LoadTrialReport {
+    double offeredRate = 0;
+    double achievedRate = 0;
+    long long requests = 0;
+    long long completed = 0;
+    long long abandoned = 0;            // bosaltma suresi asildi, calistirilmadi
+    long long failed = 0;               // dogrulama reddi ya da istisna
+    long long maxInflight = 0;
+    double serviceP50_ms = 0, serviceP99_ms = 0;
+    double sojournP50_ms = 0, sojournP90_ms = 0, sojournP99_ms = 0, sojournP999_ms = 0, sojournMax_ms = 0;
+    bool withinSlo = false;
+};
+
+struct SaturationReport {
+    std::vector<LoadTrialReport> trials;
+    double saturationRate = 0;          // SLO'yu saglayan en yuksek hiz
+};
+
+// Havuz (DID'ler, EA kumeleri, dogrulama icin gosterimler) bir kez kurulur,
+// her deneme ayni havuzu kullanir.
+class LoadGenerator {
+public:
+    LoadGenerator(TIACParams &params, KeyGenOutput &keyOut, const LoadConfig &config);
+    ~LoadGenerator();
+
+    LoadGenerator(const LoadGenerator &) = delete;
+    LoadGenerator &operator=(const LoadGenerator &) = delete;
+
+    LoadTrialReport runTrial(double rate);
+    // startRate'ten step ile artirip ilk SLO ihlalinden sonra ikili arama
+    SaturationReport findSaturation(double startRate);
+
+private:
+    struct Pool;
+    TIACParams &params_;
+    KeyGenOutput &keyOut_;
+    LoadConfig config_;
+    std::unique_ptr<Pool> pool_;
+};
+
+#endif
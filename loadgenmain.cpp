@@ -0,0 +1,147 @@
+#include <iostream>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <string>
+#include "setup.h"
+#include "keygen.h"
+#include "loadgen.h"
+#include "memstat.h"
+#include "rng.h"
+#include "trace.h"
+#include "metrics.h"
+using Clock = std::chrono::steady_clock;
+
+static void printTrial(const LoadTrialReport &r) {
+    std::cout << "Hiz " << r.offeredRate << "/s -> " << r.achievedRate << "/s"
+              << " | servis p50 " << r.serviceP50_ms << " p99 " << r.serviceP99_ms << " ms"
+              << " | sojourn p50 " << r.sojournP50_ms << " p90 " << r.sojournP90_ms
+              << " p99 " << r.sojournP99_ms << " p99.9 " << r.sojournP999_ms << " max " << r.sojournMax_ms << " ms"
+              << " | kuyruk<=" << r.maxInflight
+              << " | " << r.completed << "/" << r.requests;
+    if (r.failed > 0 || r.abandoned > 0) {
+        std::cout << " (hata " << r.failed << ", atlanan " << r.abandoned << ")";
+    }
+    std::cout << (r.withinSlo ? "  OK\n" : "  SLO ASILDI\n");
+}
+
+int main() {
+    int ne = 0;
+    int t = 0;
+    bool hasSeed = false;
+    uint64_t seed = 0;
+    LoadConfig config;
+    double rate = 10.0;
+    bool search = true;
+    std::string tracePath;
+    std::string traceJsonPath;
+    int metricsPort = 0;
+    {
+        std::ifstream infile("params.txt");
+        if (!infile) {
+            std::cerr << "Error: params.txt acilamadi!\n";
+            return 1;
+        }
+        std::string line;
+        while (std::getline(infile, line)) {
+            if (line.rfind("ea=", 0) == 0)
+                ne = std::stoi(line.substr(3));
+            else if (line.rfind("threshold=", 0) == 0)
+                t = std::stoi(line.substr(10));
+            else if (line.rfind("seed=", 0) == 0) {
+                seed = std::stoull(line.substr(5));
+                hasSeed = true;
+            }
+            else if (line.rfind("load_arrival=", 0) == 0)
+                config.arrival = parseArrivalKind(line.substr(13));
+            else if (line.rfind("load_rate=", 0) == 0)
+                rate = std::stod(line.substr(10));
+            else if (line.rfind("load_duration_s=", 0) == 0)
+                config.duration_s = std::stod(line.substr(16));
+            else if (line.rfind("load_verify_ratio=", 0) == 0)
+                config.verifyRatio = std::stod(line.substr(18));
+            else if (line.rfind("load_workers=", 0) == 0)
+                config.workers = std::stoi(line.substr(13));
+            else if (line.rfind("load_pool=", 0) == 0)
+                config.pool = std::stoi(line.substr(10));
+            else if (line.rfind("load_burst_factor=", 0) == 0)
+                config.burstFactor = std::stod(line.substr(18));
+            else if (line.rfind("load_burst_period_ms=", 0) == 0)
+                config.burstPeriod_ms = std::stod(line.substr(21));
+            else if (line.rfind("load_trace=", 0) == 0)
+                tracePath = line.substr(11);
+            else if (line.rfind("trace_json=", 0) == 0)
+                traceJsonPath = line.substr(11);
+            else if (line.rfind("metrics_port=", 0) == 0)
+                metricsPort = std::stoi(line.substr(13));
+            else if (line.rfind("load_slo_ms=", 0) == 0)
+                config.slo_ms = std::stod(line.substr(12));
+            else if (line.rfind("load_search=", 0) == 0)
+                search = std::stoi(line.substr(12)) != 0;
+            else if (line.rfind("load_step=", 0) == 0)
+                config.step = std::stod(line.substr(10));
+            else if (line.rfind("load_refine=", 0) == 0)
+                config.refineSteps = std::stoi(line.substr(12));
+        }
+        infile.close();
+    }
+    config.t = t;
+    if (!tracePath.empty()) {
+        // Her satirda bir gelis ani (ms)
+        std::ifstream trace(tracePath);
+        if (!trace) {
+            std::cerr << "Error: " << tracePath << " acilamadi!\n";
+            return 1;
+        }
+        double at;
+        while (trace >> at) {
+            config.trace_ms.push_back(at);
+        }
+    }
+
+    if (hasSeed) {
+        installDeterministicRandom(seed);
+    } else {
+        installThreadRandom();
+    }
+    if (!traceJsonPath.empty()) {
+        traceEnable(traceJsonPath);
+    }
+    std::unique_ptr<MetricsServer> metricsServer;
+    if (metricsPort > 0) {
+        metricsServer.reset(new MetricsServer(metricsPort));
+    }
+
+    auto programStart = Clock::now();
+    TIACParams params = setupParams();
+    ParamsGuard paramsGuard{params};
+    KeyGenOutput keyOut = keygen(params, t, ne);
+
+    auto poolStart = Clock::now();
+    LoadGenerator generator(params, keyOut, config);
+    auto poolEnd = Clock::now();
+
+    std::cout << "=== Acik Dongu Yuk Testi ===\n";
+    std::cout << "EA / Esik          : " << ne << " / " << t << "\n";
+    std::cout << "Gelis sureci       : " << arrivalKindName(config.arrival) << ", " << config.duration_s << " s/deneme\n";
+    std::cout << "Dogrulama orani    : " << config.verifyRatio << "\n";
+    std::cout << "SLO (p99 sojourn)  : " << config.slo_ms << " ms\n";
+    if (metricsServer) {
+        std::cout << "Metrikler          : http://127.0.0.1:" << metricsPort << "/metrics\n";
+    }
+    std::cout << "Havuz hazirlama    : " << std::chrono::duration_cast<std::chrono::microseconds>(poolEnd - poolStart).count() / 1000.0 << " ms\n";
+
+    if (search) {
+        SaturationReport rep = generator.findSaturation(rate);
+        for (const LoadTrialReport &r : rep.trials) {
+            printTrial(r);
+        }
+        std::cout << "Doygunluk hizi     : " << rep.saturationRate << " istek/s\n";
+    } else {
+        printTrial(generator.runTrial(rate));
+    }
+    std::cout << "Peak RSS           : " << peakRssKb() << " KB\n";
+    std::cout << "Total execution    : " << std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - programStart).count() / 1000.0 << " ms\n";
+    std::cout << "\n=== Program Sonu ===\n";
+    return 0;
+}
@@ -20,6 +20,16 @@
 #include "pairinginverify.h"
 #include "checkkorverify.h"
 #include "kor.h"
+#include "doubleshow.h"
+#include "tally.h"
+#include "voterbatch.h"
+#include "wire.h"
+#include "credstore.h"
+#include "pipeline.h"
+#include "memstat.h"
+#include "latencyhist.h"
+#include "rng.h"
+#include "perfcount.h"
 using Clock = std::chrono::steady_clock;
 
 struct PipelineTiming {
@@ -45,6 +55,13 @@ int main() {
     int ne = 0;       
     int t  = 0;       
     int voterCount = 0; 
+    bool hasSeed = false;
+    uint64_t seed = 0;
+    std::string mode = "batch";
+    int chunkSize = 1000;
+    std::string storePath;
+    std::string benchJsonPath;
+    bool perfCounters = false;
     {
         std::ifstream infile("params.txt");
         if (!infile) {
@@ -59,12 +76,70 @@ int main() {
                 t = std::stoi(line.substr(10));
             else if (line.rfind("votercount=", 0) == 0)
                 voterCount = std::stoi(line.substr(11));
+            else if (line.rfind("seed=", 0) == 0) {
+                seed = std::stoull(line.substr(5));
+                hasSeed = true;
+            }
+            else if (line.rfind("mode=", 0) == 0)
+                mode = line.substr(5);
+            else if (line.rfind("chunksize=", 0) == 0)
+                chunkSize = std::stoi(line.substr(10));
+            else if (line.rfind("store=", 0) == 0)
+                storePath = line.substr(6);
+            else if (line.rfind("bench_json=", 0) == 0)
+                benchJsonPath = line.substr(11);
+            else if (line.rfind("perf_counters=", 0) == 0)
+                perfCounters = std::stoi(line.substr(14)) != 0;
         }
         infile.close();
     }
     
+    // seed= verilirse tum rastgelelik seed'den turetilir (tekrarlanabilir benchmark)
+    if (hasSeed) {
+        installDeterministicRandom(seed);
+    } else {
+        installThreadRandom();
+    }
+    // perf_counters=1: asama basina donanim sayaclari (acilamazsa tablo nedenini yazar)
+    if (perfCounters) {
+        perfEnable();
+    }
+    
+    // mode=verify: setup/keygen/ihrac yapilmaz; store= dosyasindaki
+    // gosterimler tum cekirdeklerde dogrulanir
+    if (mode == "verify") {
+        if (storePath.empty()) {
+            storePath = "credentials.store";
+        }
+        auto loadStart = Clock::now();
+        CredStoreReader store(storePath);
+        TIACParams params = setupParamsFromText(store.paramText());
+        ParamsGuard paramsGuard{params};
+        MasterVerKey mvk;
+        store.loadPublic(params, mvk);
+        auto loadEnd = Clock::now();
+        std::vector<char> ok;
+        auto verStart = Clock::now();
+        size_t valid = verifyStore(params, mvk, store, ok);
+        auto verEnd = Clock::now();
+        auto load_us = std::chrono::duration_cast<std::chrono::microseconds>(loadEnd - loadStart).count();
+        auto ver_us = std::chrono::duration_cast<std::chrono::microseconds>(verEnd - verStart).count();
+        std::cout << "=== Verify-only (" << storePath << ") ===\n";
+        std::cout << "Store open + keys  : " << load_us / 1000.0 << " ms\n";
+        std::cout << "Records            : " << store.count() << " (" << store.recordSize() << " B/kayit)\n";
+        std::cout << "Valid              : " << valid << "\n";
+        std::cout << "Total Verification : " << ver_us / 1000.0 << " ms\n";
+        if (ver_us > 0) {
+            std::cout << "Throughput         : " << store.count() * 1e6 / ver_us << " dogrulama/s\n";
+        }
+        std::cout << "Peak RSS           : " << peakRssKb() << " KB\n";
+        std::cout << "\n=== Program Sonu ===\n";
+        return valid == store.count() ? 0 : 2;
+    }
+    
     auto startSetup = Clock::now();
     TIACParams params = setupParams();
+    ParamsGuard paramsGuard{params};
     auto endSetup = Clock::now();
     auto setup_us = std::chrono::duration_cast<std::chrono::microseconds>(endSetup - startSetup).count();
     
@@ -76,16 +151,80 @@ int main() {
     auto pairing_us = std::chrono::duration_cast<std::chrono::microseconds>(endPairing - startPairing).count();
     element_clear(pairingTest);
     
+    // e(a,b) == e(c,d) kontrolu: iki ayri pairing + element_cmp ile
+    // tek final exponentiation'li pairingProductIsOne karsilastirmasi
+    const int pairingBenchReps = 100;
+    element_t benchLhs, benchRhs, g1Inv;
+    element_init_GT(benchLhs, params.pairing);
+    element_init_GT(benchRhs, params.pairing);
+    element_init_G1(g1Inv, params.pairing);
+    element_invert(g1Inv, params.g1);
+    bool benchCmpOk = true;
+    auto startPairingCmp = Clock::now();
+    for (int i = 0; i < pairingBenchReps; i++) {
+        pairing_apply(benchLhs, params.g1, params.g2, params.pairing);
+        pairing_apply(benchRhs, params.g1, params.g2, params.pairing);
+        benchCmpOk = benchCmpOk && (element_cmp(benchLhs, benchRhs) == 0);
+    }
+    auto endPairingCmp = Clock::now();
+    bool benchProdOk = true;
+    auto startPairingProd = Clock::now();
+    for (int i = 0; i < pairingBenchReps; i++) {
+        benchProdOk = benchProdOk && pairingProductIsOne(params, {
+            {params.g1, params.g2},
+            {g1Inv, params.g2}
+        });
+    }
+    auto endPairingProd = Clock::now();
+    element_clear(benchLhs);
+    element_clear(benchRhs);
+    element_clear(g1Inv);
+    if (!benchCmpOk || !benchProdOk) {
+        throw std::runtime_error("Pairing benchmark: e(g1,g2) == e(g1,g2) saglanmadi");
+    }
+    auto pairingCmp_us = std::chrono::duration_cast<std::chrono::microseconds>(endPairingCmp - startPairingCmp).count();
+    auto pairingProd_us = std::chrono::duration_cast<std::chrono::microseconds>(endPairingProd - startPairingProd).count();
+    
     auto startKeygen = Clock::now();
     KeyGenOutput keyOut = keygen(params, t, ne);
     auto endKeygen = Clock::now();
     auto keygen_us = std::chrono::duration_cast<std::chrono::microseconds>(endKeygen - startKeygen).count();
     
+    // mode=stream: secmenler chunkSize'lik parcalarla islenir, bellek sabit kalir
+    if (mode == "stream") {
+        StreamingReport rep = runStreamingIssuance(params, keyOut, voterCount, t, ne, chunkSize);
+        if (rep.verified != voterCount) {
+            throw std::runtime_error("Streaming verification failed: " + std::to_string(voterCount - rep.verified) + " show(s) rejected");
+        }
+        if (rep.tallyResult != rep.expectedTally) {
+            throw std::runtime_error("Streaming tally failed: decrypted " + std::to_string(rep.tallyResult) + ", expected " + std::to_string(rep.expectedTally));
+        }
+        auto streamEnd = Clock::now();
+        std::cout << "=== Streaming Zaman Olcumleri (ms) ===\n";
+        std::cout << "Chunk size         : " << chunkSize << " (" << rep.chunks << " chunk)\n";
+        std::cout << "Setup suresi       : " << setup_us / 1000.0 << " ms\n";
+        std::cout << "KeyGen suresi      : " << keygen_us / 1000.0 << " ms\n";
+        std::cout << "DID Generation     : " << rep.times.didGen_us / 1000.0 << " ms\n";
+        std::cout << "Prepare Phase      : " << rep.times.prep_us / 1000.0 << " ms\n";
+        std::cout << "BlindSign Phase    : " << rep.times.blind_us / 1000.0 << " ms\n";
+        std::cout << "Unblind Phase      : " << rep.times.unblind_us / 1000.0 << " ms\n";
+        std::cout << "Aggregate Phase    : " << rep.times.aggregate_us / 1000.0 << " ms\n";
+        std::cout << "ProveCredential    : " << rep.times.prove_us / 1000.0 << " ms\n";
+        std::cout << "KoR Generation     : " << rep.times.kor_us / 1000.0 << " ms\n";
+        std::cout << "Total Verification : " << rep.times.verify_us / 1000.0 << " ms\n";
+        std::cout << "Ballot Encryption  : " << rep.times.ballot_us / 1000.0 << " ms\n";
+        std::cout << "Tally (acc+dec)    : " << rep.times.tally_us / 1000.0 << " ms\n";
+        std::cout << "Tally Result       : " << rep.tallyResult << " / " << voterCount << "\n";
+        std::cout << "Peak RSS           : " << rep.peakRssKb << " KB\n";
+        std::cout << "Total execution    : " << std::chrono::duration_cast<std::chrono::microseconds>(streamEnd - programStart).count() / 1000.0 << " ms\n";
+        std::cout << "\n=== Program Sonu ===\n";
+        return 0;
+    }
+    
     auto startIDGen = Clock::now();
     std::vector<std::string> voterIDs(voterCount);
     {
-        std::random_device rd;
-        std::mt19937_64 gen(rd());
+        std::mt19937_64 gen(randomU64());
         std::uniform_int_distribution<unsigned long long> dist(10000000000ULL, 99999999999ULL);
         for (int i = 0; i < voterCount; i++) {
             unsigned long long id = dist(gen);
@@ -96,22 +235,40 @@ int main() {
     auto idGen_us = std::chrono::duration_cast<std::chrono::microseconds>(endIDGen - startIDGen).count();
     
     auto startDIDGen = Clock::now();
-    std::vector<DID> dids(voterCount);
-    for (int i = 0; i < voterCount; i++) {
-        dids[i] = createDID(params, voterIDs[i]);
+    PerfStage didPerf("DID Generation");
+    std::vector<DID> dids;
+    {
+        OPCOUNT_STAGE("createDID");
+        dids = createDIDs(params, voterIDs);
     }
+    didPerf.stop();
     auto endDIDGen = Clock::now();
     auto didGen_us = std::chrono::duration_cast<std::chrono::microseconds>(endDIDGen - startDIDGen).count();
     
+    // Islem basina gecikme dagilimi (her cagri ayri olculur)
+    LatencyRecorder latency;
+    LatencyHistogram &prepHist = latency.op("prepareBlindSign");
+    LatencyHistogram &blindHist = latency.op("blindSign");
+    LatencyHistogram &unblindHist = latency.op("unblindSign");
+    LatencyHistogram &aggregateHist = latency.op("aggregateSign");
+    LatencyHistogram &proveHist = latency.op("proveCredential");
+    LatencyHistogram &korHist = latency.op("generateKoRProof");
+    LatencyHistogram &pairingCheckHist = latency.op("pairingCheck");
+    LatencyHistogram &korVerHist = latency.op("checkKoRVerify");
+    
     std::vector<PipelineResult> pipelineResults(voterCount);
     auto pipelineStart = Clock::now();
     
     // Prepare BlindSign işlemleri - sıralı (sequential) çalışır
     auto prepStart = Clock::now();
+    PerfStage prepPerf("Prepare Phase");
     std::vector<PrepareBlindSignOutput> preparedOutputs(voterCount);
     for(int i = 0; i < voterCount; i++){
+        LatencyScope scope(prepHist);
+        OPCOUNT_STAGE("prepareBlindSign");
         preparedOutputs[i] = prepareBlindSign(params, dids[i].did);
     }
+    prepPerf.stop();
     auto prepEnd = Clock::now();
     auto prepTime = std::chrono::duration_cast<std::chrono::microseconds>(prepEnd - prepStart).count();
     
@@ -123,8 +280,7 @@ int main() {
     };
     std::vector<SignTask> tasks;
     tasks.reserve(voterCount * t);
-    std::random_device rd;
-    std::mt19937 rng(rd());
+    std::mt19937 rng(randomU64());
     
     for (int i = 0; i < voterCount; i++) {
         pipelineResults[i].signatures.resize(t);
@@ -143,22 +299,18 @@ int main() {
     
     // BlindSign işlemleri - sıralı (sequential) çalışır
     auto blindStart = Clock::now();
+    PerfStage blindPerf("BlindSign Phase");
     for(int idx = 0; idx < (int)tasks.size(); idx++) {
         const SignTask &st = tasks[idx];
         int vId = st.voterId;
         int j = st.indexInVoter;
         int aId = st.adminId;
         
-        mpz_t xm, ym;
-        mpz_init(xm);
-        mpz_init(ym);
-        element_to_mpz(xm, keyOut.eaKeys[aId].sgk1);
-        element_to_mpz(ym, keyOut.eaKeys[aId].sgk2);
-        BlindSignature sig = blindSign(params, preparedOutputs[vId], xm, ym, aId, vId);
-        mpz_clear(xm);
-        mpz_clear(ym);
-        pipelineResults[vId].signatures[j] = sig;
+        LatencyScope scope(blindHist);
+        OPCOUNT_STAGE("blindSign");
+        pipelineResults[vId].signatures[j] = blindSign(params, preparedOutputs[vId], keyOut.eaKeys[aId].sgk1, keyOut.eaKeys[aId].sgk2, aId, vId);
     }
+    blindPerf.stop();
     auto blindEnd = Clock::now();
     auto blindTime = std::chrono::duration_cast<std::chrono::microseconds>(blindEnd - blindStart).count();
     
@@ -173,21 +325,22 @@ int main() {
     
     // Unblind işlemleri - sıralı (sequential) çalışır
     auto unblindStart = Clock::now();
+    PerfStage unblindPerf("Unblind Phase");
     std::vector<std::vector<std::pair<int, UnblindSignature>>> unblindResultsWithAdmin(voterCount);
-    std::vector<std::vector<UnblindSignature>> unblindResults(voterCount);
     
     for(int i = 0; i < voterCount; i++) {
         int numSigs = (int) pipelineResults[i].signatures.size();
-        unblindResults[i].resize(numSigs);
         unblindResultsWithAdmin[i].resize(numSigs);
         
         for(int j = 0; j < numSigs; j++) {
             int adminId = pipelineResults[i].signatures[j].adminId; 
-            UnblindSignature usig = unblindSign(params, preparedOutputs[i], pipelineResults[i].signatures[j], keyOut.eaKeys[adminId], dids[i].did);
-            unblindResults[i][j] = usig;
-            unblindResultsWithAdmin[i][j] = {adminId, usig};
+            LatencyScope scope(unblindHist);
+            OPCOUNT_STAGE("unblindSign");
+            UnblindSignature usig = unblindSign(params, preparedOutputs[i], pipelineResults[i].signatures[j], keyOut.eaKeys[adminId]);
+            unblindResultsWithAdmin[i][j] = {adminId, std::move(usig)};
         }
     }
+    unblindPerf.stop();
     auto unblindEnd = Clock::now();
     auto unblind_us = std::chrono::duration_cast<std::chrono::microseconds>(unblindEnd - unblindStart).count();
     
@@ -201,93 +354,102 @@ int main() {
     // Aggregate işlemleri - sıralı (sequential) çalışır
     std::vector<AggregateSignature> aggregateResults(voterCount);
     auto aggregateStart = Clock::now();
+    PerfStage aggregatePerf("Aggregate Phase");
     
     for(int i = 0; i < voterCount; i++) {
-        AggregateSignature aggSig = aggregateSign(params, unblindResultsWithAdmin[i], keyOut.mvk, dids[i].did, params.prime_order);
-        aggregateResults[i] = aggSig;
+        LatencyScope scope(aggregateHist);
+        OPCOUNT_STAGE("aggregateSign");
+        aggregateResults[i] = aggregateSign(params, unblindResultsWithAdmin[i], keyOut.mvk, dids[i].did, params.prime_order);
     }
     
+    aggregatePerf.stop();
     auto aggregateEnd = Clock::now();
     auto aggregate_us = std::chrono::duration_cast<std::chrono::microseconds>(aggregateEnd - aggregateStart).count();
     
     // Prove Credential işlemleri - sıralı (sequential) çalışır
     std::vector<ProveCredentialOutput> proveResults(voterCount);
     auto proveStart = Clock::now();
+    PerfStage provePerf("ProveCredential");
     
     for(int i = 0; i < voterCount; i++) {
-        ProveCredentialOutput pOut = proveCredential(params, aggregateResults[i], keyOut.mvk, dids[i].did, preparedOutputs[i].o);
-        proveResults[i] = pOut;
+        LatencyScope scope(proveHist);
+        OPCOUNT_STAGE("proveCredential");
+        proveResults[i] = proveCredential(params, aggregateResults[i], keyOut.mvk, preparedOutputs[i].did, preparedOutputs[i].o);
     }
     
+    provePerf.stop();
     auto proveEnd = Clock::now();
     auto prove_us = std::chrono::duration_cast<std::chrono::microseconds>(proveEnd - proveStart).count();
     
     // KoR üretimi - sıralı (sequential) çalışır
     auto korStart = Clock::now();
+    PerfStage korPerf("KoR Generation");
     
     for(int i = 0; i < voterCount; i++) {
-        mpz_t did_int;
-        mpz_init(did_int);
-        mpz_set_str(did_int, dids[i].did.c_str(), 16);
-        mpz_mod(did_int, did_int, params.prime_order);
-        
-        element_t com_elem;
-        element_init_G1(com_elem, params.pairing);
-        try {
-            stringToElement(com_elem, preparedOutputs[i].com_str, params.pairing, 1);
-        } catch (const std::exception& e) {
-            std::cerr << "Error converting com string to element: " << e.what() << std::endl;
-            element_random(com_elem);
-        }
-        
+        OPCOUNT_STAGE("generateKoRProof");
+        auto korCallStart = Clock::now();
         KnowledgeOfRepProof korProof = generateKoRProof(
             params,
-            aggregateResults[i].h,
+            preparedOutputs[i],
             proveResults[i].k,
             proveResults[i].r,
-            com_elem,
             keyOut.mvk.alpha2,
-            keyOut.mvk.beta2,
-            did_int,
-            preparedOutputs[i].o
+            keyOut.mvk.beta2
         );
+        korHist.record(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - korCallStart).count());
         
         element_set(proveResults[i].c, korProof.c);
         element_set(proveResults[i].s1, korProof.s1);
         element_set(proveResults[i].s2, korProof.s2);
         element_set(proveResults[i].s3, korProof.s3);
         proveResults[i].proof_v = korProof.proof_string;
-        
-        element_clear(com_elem);
-        element_clear(korProof.c);
-        element_clear(korProof.s1);
-        element_clear(korProof.s2);
-        element_clear(korProof.s3);
-        mpz_clear(did_int);
     }
     
+    korPerf.stop();
     auto korEnd = Clock::now();
     auto kor_us = std::chrono::duration_cast<std::chrono::microseconds>(korEnd - korStart).count();
     
+    // store= verildiyse gosterimler verify-only modu icin diske eklenir
+    long long storeAppend_us = -1;
+    if (!storePath.empty()) {
+        auto storeStart = Clock::now();
+        CredStoreWriter writer(params, keyOut.mvk, storePath);
+        for(int i = 0; i < voterCount; i++) {
+            writer.append(proveResults[i], preparedOutputs[i].com, aggregateResults[i].h);
+        }
+        writer.flush();
+        storeAppend_us = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - storeStart).count();
+    }
+    
     // Pairing Check - sıralı (sequential) çalışır
     auto pairingCheckStart = Clock::now();
+    PerfStage pairingCheckPerf("Pairing Check");
     bool allPairingVerified = true;
     
     for(int i = 0; i < voterCount; i++) {
-        bool pairing_ok = pairingCheck(params, proveResults[i]);
+        bool pairing_ok;
+        {
+            LatencyScope scope(pairingCheckHist);
+            OPCOUNT_STAGE("pairingCheck");
+            pairing_ok = pairingCheck(params, proveResults[i]);
+        }
         if (!pairing_ok) {
             allPairingVerified = false;
         }
     }
     
+    pairingCheckPerf.stop();
     auto pairingCheckEnd = Clock::now();
     auto pairingCheck_us = std::chrono::duration_cast<std::chrono::microseconds>(pairingCheckEnd - pairingCheckStart).count();
     
     // KoR Verify - sıralı (sequential) çalışır
     auto korVerStart = Clock::now();
+    PerfStage korVerPerf("KoR Verification");
     bool allKorVerified = true;
     
     for(int i = 0; i < voterCount; i++) {
+        LatencyScope scope(korVerHist);
+        OPCOUNT_STAGE("checkKoRVerify");
         bool kor_ok = checkKoRVerify(
             params,
             proveResults[i],
@@ -300,60 +462,124 @@ int main() {
         }
     }
     
+    korVerPerf.stop();
     auto korVerEnd = Clock::now();
     auto korVer_us = std::chrono::duration_cast<std::chrono::microseconds>(korVerEnd - korVerStart).count();
     
-    // Toplam doğrulama süresi
-    auto totalVerStart = Clock::now();
-    bool allVerified = true;
-    
+    // Secmen durumunu sutun yerlesimine (VoterBatch) aktar
+    auto packStart = Clock::now();
+    VoterBatch batch;
+    initVoterBatch(params, batch, voterCount);
     for(int i = 0; i < voterCount; i++) {
-        bool pairing_ok = pairingCheck(params, proveResults[i]);
-        bool kor_ok = checkKoRVerify(
-            params,
-            proveResults[i],
-            keyOut.mvk,
-            preparedOutputs[i].com_str, 
-            aggregateResults[i].h
-        );
-        
-        bool verified = pairing_ok && kor_ok;
-        if (!verified) {
-            allVerified = false;
-        }
+        storeCredential(batch, i, preparedOutputs[i], aggregateResults[i], proveResults[i]);
+    }
+    auto packEnd = Clock::now();
+    auto pack_us = std::chrono::duration_cast<std::chrono::microseconds>(packEnd - packStart).count();
+    
+    // Gosterim kanitlarinin ikili tel formati: hepsi tek tampona kodlanir,
+    // sonra onceden init edilmis hedeflere ayirma yapmadan cozulur
+    WireCodec codec = makeWireCodec(params);
+    size_t showFrame = wireFrameSize(codec, WireType::ShowProof);
+    size_t showRaw = 4 * (size_t)pairing_length_in_bytes_G1(params.pairing)
+                   + (size_t)pairing_length_in_bytes_G2(params.pairing)
+                   + 4 * (size_t)pairing_length_in_bytes_Zr(params.pairing);
+    std::vector<unsigned char> wireBuf(showFrame * voterCount);
+    auto wireEncStart = Clock::now();
+    for(int i = 0; i < voterCount; i++) {
+        encodeShowProof(codec, proveResults[i], preparedOutputs[i].com, aggregateResults[i].h, wireBuf.data() + i * showFrame);
+    }
+    auto wireEncEnd = Clock::now();
+    ProveCredentialOutput wireProof;
+    Element wireCom, wireHAgg;
+    initShowProof(params, wireProof, wireCom, wireHAgg);
+    bool wireOk = true;
+    auto wireDecStart = Clock::now();
+    for(int i = 0; i < voterCount; i++) {
+        decodeShowProof(codec, wireBuf.data() + i * showFrame, showFrame, wireProof, wireCom, wireHAgg);
+        wireOk = wireOk && element_cmp(wireProof.k, proveResults[i].k) == 0 && element_cmp(wireCom, preparedOutputs[i].com) == 0;
+    }
+    auto wireDecEnd = Clock::now();
+    if (!wireOk) {
+        throw std::runtime_error("Wire codec: decoded show proof does not match");
     }
+    auto wireEnc_us = std::chrono::duration_cast<std::chrono::microseconds>(wireEncEnd - wireEncStart).count();
+    auto wireDec_us = std::chrono::duration_cast<std::chrono::microseconds>(wireDecEnd - wireDecStart).count();
     
+    // Toplam doğrulama süresi - ayni gosterim iki kez gelirse pairing'e gitmeden reddedilir
+    DoubleShowIndex showIndex(voterCount);
+    std::vector<char> showOk;
+    auto totalVerStart = Clock::now();
+    PerfStage totalVerPerf("Total Verification", true);
+    size_t validShows;
+    {
+        OPCOUNT_PARALLEL_STAGE("verifyShowBatch");
+        validShows = verifyShowBatch(params, keyOut.mvk, batch, showIndex, showOk);
+    }
+    totalVerPerf.stop();
     auto totalVerEnd = Clock::now();
     auto totalVer_us = std::chrono::duration_cast<std::chrono::microseconds>(totalVerEnd - totalVerStart).count();
     
-    if (!allVerified) {
-        throw std::runtime_error("Verification failed: pairing check or KoR verification returned false");
+    if (validShows != (size_t)voterCount) {
+        throw std::runtime_error("Verification failed: " + std::to_string(voterCount - (int)validShows) + " show(s) rejected (duplicate, pairing or KoR)");
     }
     
-    // Kaynakları temizle
-    element_clear(keyOut.mvk.alpha2);
-    element_clear(keyOut.mvk.beta2);
-    element_clear(keyOut.mvk.beta1);
-    
-    for (int i = 0; i < ne; i++) {
-        element_clear(keyOut.eaKeys[i].sgk1);
-        element_clear(keyOut.eaKeys[i].sgk2);
-        element_clear(keyOut.eaKeys[i].vkm1);
-        element_clear(keyOut.eaKeys[i].vkm2);
-        element_clear(keyOut.eaKeys[i].vkm3);
+    // Oylama ve sayim - DLog tablosu sandiklar kapanmadan once hazirlanir
+    auto dlogStart = Clock::now();
+    DlogTable dlogTable = buildDlogTable(params, voterCount);
+    auto dlogEnd = Clock::now();
+    auto dlog_us = std::chrono::duration_cast<std::chrono::microseconds>(dlogEnd - dlogStart).count();
+    
+    // Oy sifreleme - sıralı (sequential) çalışır
+    long long expectedTally = 0;
+    std::uniform_int_distribution<int> voteDist(0, 1);
+    auto ballotStart = Clock::now();
+    PerfStage ballotPerf("Ballot Encryption");
+    for(int i = 0; i < voterCount; i++) {
+        int vote = voteDist(rng);
+        expectedTally += vote;
+        OPCOUNT_STAGE("encryptBallot");
+        Ballot ballot = encryptBallot(params, keyOut.mvk.beta1, vote);
+        storeBallot(batch, i, ballot);
+    }
+    ballotPerf.stop();
+    auto ballotEnd = Clock::now();
+    auto ballot_us = std::chrono::duration_cast<std::chrono::microseconds>(ballotEnd - ballotStart).count();
+    
+    // Sifreli metinlerin paralel toplanmasi
+    auto tallyStart = Clock::now();
+    PerfStage tallyPerf("Tally Accumulate", true);
+    TallyAccumulator tally;
+    initTally(params, tally);
+    accumulateBallots(params, tally, batch, showOk);
+    tallyPerf.stop();
+    auto tallyEnd = Clock::now();
+    auto tally_us = std::chrono::duration_cast<std::chrono::microseconds>(tallyEnd - tallyStart).count();
+    
+    // Esik sifre cozme: ilk t EA kismi cozum uretir
+    auto decryptStart = Clock::now();
+    PerfStage decryptPerf("Tally Decryption");
+    std::vector<PartialDecryption> partials;
+    for (int m = 0; m < t; m++) {
+        partials.push_back(partialDecrypt(params, tally, keyOut.eaKeys[m], m));
     }
+    long long tallyResult = decryptTally(params, tally, partials, dlogTable);
+    decryptPerf.stop();
+    auto decryptEnd = Clock::now();
+    auto decrypt_us = std::chrono::duration_cast<std::chrono::microseconds>(decryptEnd - decryptStart).count();
     
-    for (int i = 0; i < voterCount; i++) {
-        mpz_clear(dids[i].x);
+    if (tallyResult != expectedTally) {
+        throw std::runtime_error("Tally failed: decrypted " + std::to_string(tallyResult) + ", expected " + std::to_string(expectedTally));
     }
     
-    clearParams(params);
+    // Kaynaklar RAII ile temizlenir; pairing paramsGuard ile en son
     
     auto programEnd = Clock::now();
     auto totalDuration = std::chrono::duration_cast<std::chrono::microseconds>(programEnd - programStart).count();
     
     double setup_ms    = setup_us    / 1000.0;
     double pairing_ms  = pairing_us  / 1000.0;
+    double pairingCmp_ms  = pairingCmp_us  / 1000.0 / pairingBenchReps;
+    double pairingProd_ms = pairingProd_us / 1000.0 / pairingBenchReps;
     double keygen_ms   = keygen_us   / 1000.0;
     double idGen_ms    = idGen_us    / 1000.0;
     double didGen_ms   = didGen_us   / 1000.0;
@@ -365,12 +591,21 @@ int main() {
     double kor_ms      = kor_us      / 1000.0;
     double pairingCheck_ms = pairingCheck_us / 1000.0;
     double korVer_ms   = korVer_us   / 1000.0;
+    double pack_ms     = pack_us     / 1000.0;
+    double wireEnc_ms  = wireEnc_us  / 1000.0;
+    double wireDec_ms  = wireDec_us  / 1000.0;
     double totalVer_ms = totalVer_us / 1000.0;
+    double dlog_ms     = dlog_us     / 1000.0;
+    double ballot_ms   = ballot_us   / 1000.0;
+    double tally_ms    = tally_us    / 1000.0;
+    double decrypt_ms  = decrypt_us  / 1000.0;
     double total_ms    = totalDuration / 1000.0;
     
     std::cout << "=== Zaman Olcumleri (ms) ===\n";
     std::cout << "Setup suresi       : " << setup_ms    << " ms\n";
     std::cout << "Pairing suresi     : " << pairing_ms  << " ms\n";
+    std::cout << "2x Pairing + cmp   : " << pairingCmp_ms  << " ms/op\n";
+    std::cout << "Pairing Product    : " << pairingProd_ms << " ms/op\n";
     std::cout << "KeyGen suresi      : " << keygen_ms   << " ms\n";
     std::cout << "ID Generation      : " << idGen_ms    << " ms\n";
     std::cout << "DID Generation     : " << didGen_ms   << " ms\n";
@@ -382,8 +617,69 @@ int main() {
     std::cout << "KoR Generation     : " << kor_ms      << " ms\n";
     std::cout << "Pairing Check      : " << pairingCheck_ms << " ms\n";
     std::cout << "KoR Verification   : " << korVer_ms   << " ms\n";
+    std::cout << "VoterBatch Pack    : " << pack_ms     << " ms\n";
+    std::cout << "Wire Show Proof    : " << showFrame << " B (sikistirmasiz " << showRaw << " B)\n";
+    std::cout << "Wire Encode        : " << wireEnc_ms  << " ms\n";
+    std::cout << "Wire Decode        : " << wireDec_ms  << " ms\n";
+    if (storeAppend_us >= 0) {
+        std::cout << "CredStore Append   : " << storeAppend_us / 1000.0 << " ms (" << storePath << ")\n";
+    }
     std::cout << "Total Verification : " << totalVer_ms << " ms\n";
+    std::cout << "DLog Table         : " << dlog_ms     << " ms\n";
+    std::cout << "Ballot Encryption  : " << ballot_ms   << " ms\n";
+    std::cout << "Tally Accumulate   : " << tally_ms    << " ms\n";
+    std::cout << "Tally Decryption   : " << decrypt_ms  << " ms\n";
+    std::cout << "Tally Result       : " << tallyResult << " / " << voterCount << "\n";
+    std::cout << "Peak RSS           : " << peakRssKb() << " KB\n";
     std::cout << "Total execution    : " << total_ms    << " ms\n";
+    
+    if (perfCounters) {
+        std::cout << "\n";
+        printPerfTable(std::cout);
+    }
+    
+    std::cout << "\n=== Gecikme Dagilimi (us) ===\n";
+    for (const auto &kv : latency.ops) {
+        const LatencyHistogram &h = kv.second;
+        std::string label = kv.first;
+        label.resize(19, ' ');
+        std::cout << label << ": p50 " << h.percentile(0.50) / 1000.0
+                  << "  p90 " << h.percentile(0.90) / 1000.0
+                  << "  p99 " << h.percentile(0.99) / 1000.0
+                  << "  p99.9 " << h.percentile(0.999) / 1000.0
+                  << "  max " << h.max() / 1000.0
+                  << "  (n=" << h.count() << ", sd " << h.stddev() / 1000.0 << ")\n";
+    }
+    
+    OPCOUNT_REPORT(std::cout, voterCount);
+    
+    if (!benchJsonPath.empty()) {
+        BenchReport report;
+        report.benchmark = "eVoting";
+        report.config = {
+            {"mode", jsonString(mode)},
+            {"ea", std::to_string(ne)},
+            {"threshold", std::to_string(t)},
+            {"votercount", std::to_string(voterCount)},
+            {"seed", hasSeed ? std::to_string(seed) : "null"},
+            {"rbits", std::to_string(mpz_sizeinbase(params.prime_order, 2))},
+            {"g1_bytes", std::to_string(pairing_length_in_bytes_G1(params.pairing))}
+        };
+        report.phases_ms = {
+            {"setup", setup_ms}, {"keygen", keygen_ms}, {"did", didGen_ms},
+            {"prepare", prep_ms}, {"blindsign", blind_ms}, {"unblind", unblind_ms},
+            {"aggregate", aggregate_ms}, {"prove", prove_ms}, {"kor", kor_ms},
+            {"pairing_check", pairingCheck_ms}, {"kor_verify", korVer_ms},
+            {"total_verification", totalVer_ms}, {"ballot", ballot_ms},
+            {"tally", tally_ms}, {"decrypt", decrypt_ms}
+        };
+        double issuance_ms = prep_ms + blind_ms + unblind_ms + aggregate_ms + prove_ms + kor_ms;
+        report.voters_per_s = issuance_ms > 0 ? voterCount * 1000.0 / issuance_ms : 0.0;
+        report.total_ms = total_ms;
+        report.peakRssKb = peakRssKb();
+        writeBenchJson(benchJsonPath, report, latency);
+        std::cout << "Benchmark JSON     : " << benchJsonPath << "\n";
+    }
     std::cout << "\n=== Program Sonu ===\n";
     
     return 0;
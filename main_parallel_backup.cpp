@@ -21,6 +21,10 @@
 #include "pairinginverify.h"
 #include "checkkorverify.h"
 #include "kor.h"
+#include "voterchain.h"
+#include "sweep.h"
+#include "rng.h"
+#include "trace.h"
 using Clock = std::chrono::steady_clock;
 
 struct PipelineTiming {
@@ -50,6 +54,13 @@ tbb::global_control gc(tbb::global_control::max_allowed_parallelism, max_threads
     int ne = 0;       
     int t  = 0;       
     int voterCount = 0; 
+    bool hasSeed = false;
+    uint64_t seed = 0;
+    std::string schedule = "chain";
+    std::string mode;
+    std::string traceJsonPath;
+    SweepConfig sweep;
+    std::string sweepCurves = "256:512", sweepEa, sweepThreshold, sweepVoters, sweepThreads = "0";
     {
         std::ifstream infile("params.txt");
         if (!infile) {
@@ -64,12 +75,63 @@ tbb::global_control gc(tbb::global_control::max_allowed_parallelism, max_threads
                 t = std::stoi(line.substr(10));
             else if (line.rfind("votercount=", 0) == 0)
                 voterCount = std::stoi(line.substr(11));
+            else if (line.rfind("seed=", 0) == 0) {
+                seed = std::stoull(line.substr(5));
+                hasSeed = true;
+            }
+            else if (line.rfind("schedule=", 0) == 0)
+                schedule = line.substr(9);
+            else if (line.rfind("mode=", 0) == 0)
+                mode = line.substr(5);
+            else if (line.rfind("trace_json=", 0) == 0)
+                traceJsonPath = line.substr(11);
+            else if (line.rfind("sweep_curves=", 0) == 0)
+                sweepCurves = line.substr(13);
+            else if (line.rfind("sweep_ea=", 0) == 0)
+                sweepEa = line.substr(9);
+            else if (line.rfind("sweep_threshold=", 0) == 0)
+                sweepThreshold = line.substr(16);
+            else if (line.rfind("sweep_voters=", 0) == 0)
+                sweepVoters = line.substr(13);
+            else if (line.rfind("sweep_threads=", 0) == 0)
+                sweepThreads = line.substr(14);
+            else if (line.rfind("sweep_csv=", 0) == 0)
+                sweep.csvPath = line.substr(10);
         }
         infile.close();
     }
     
+    // seed= verilirse tum rastgelelik seed'den turetilir (tekrarlanabilir benchmark)
+    if (hasSeed) {
+        installDeterministicRandom(seed);
+    } else {
+        installThreadRandom();
+    }
+    // trace_json= verilirse is parcacigi/secmen/asama zaman cizelgesi cikista yazilir
+    if (!traceJsonPath.empty()) {
+        traceEnable(traceJsonPath);
+    }
+    
+    // mode=sweep: sweep_* listelerinin tum kombinasyonlari, CSV'ye bir satir
+    // (verilmeyen listeler ea/threshold/votercount degerine duser)
+    if (mode == "sweep") {
+        sweep.curves = parseCurveList(sweepCurves);
+        sweep.eas = parseSweepList(sweepEa.empty() ? std::to_string(ne) : sweepEa);
+        sweep.thresholds = parseSweepList(sweepThreshold.empty() ? std::to_string(t) : sweepThreshold);
+        sweep.voters = parseSweepList(sweepVoters.empty() ? std::to_string(voterCount) : sweepVoters);
+        sweep.threads = parseSweepList(sweepThreads);
+        int rows = runSweep(sweep);
+        auto sweepEnd = Clock::now();
+        std::cout << "=== Parametre Taramasi ===\n";
+        std::cout << "Konfigurasyon      : " << rows << " (" << sweep.csvPath << ")\n";
+        std::cout << "Total execution    : " << std::chrono::duration_cast<std::chrono::microseconds>(sweepEnd - programStart).count() / 1000.0 << " ms\n";
+        std::cout << "\n=== Program Sonu ===\n";
+        return 0;
+    }
+    
     auto startSetup = Clock::now();
     TIACParams params = setupParams();
+    ParamsGuard paramsGuard{params};
     auto endSetup = Clock::now();
     auto setup_us = std::chrono::duration_cast<std::chrono::microseconds>(endSetup - startSetup).count();
     
@@ -89,8 +151,7 @@ tbb::global_control gc(tbb::global_control::max_allowed_parallelism, max_threads
     auto startIDGen = Clock::now();
     std::vector<std::string> voterIDs(voterCount);
     {
-        std::random_device rd;
-        std::mt19937_64 gen(rd());
+        std::mt19937_64 gen(randomU64());
         std::uniform_int_distribution<unsigned long long> dist(10000000000ULL, 99999999999ULL);
         for (int i = 0; i < voterCount; i++) {
             unsigned long long id = dist(gen);
@@ -101,20 +162,65 @@ tbb::global_control gc(tbb::global_control::max_allowed_parallelism, max_threads
     auto idGen_us = std::chrono::duration_cast<std::chrono::microseconds>(endIDGen - startIDGen).count();
     
     auto startDIDGen = Clock::now();
-    std::vector<DID> dids(voterCount);
-    for (int i = 0; i < voterCount; i++) {
-        dids[i] = createDID(params, voterIDs[i]);
-    }
+    std::vector<DID> dids = createDIDs(params, voterIDs);
     auto endDIDGen = Clock::now();
     auto didGen_us = std::chrono::duration_cast<std::chrono::microseconds>(endDIDGen - startDIDGen).count();
     
+    // schedule=chain (varsayilan): secmen basina bagimlilik zinciri, asamalar
+    // arasinda bariyer yok. schedule=phase: asama asama parallel_for.
+    if (schedule == "chain") {
+        std::vector<std::vector<int>> adminSets(voterCount);
+        std::mt19937 rng(randomU64());
+        std::vector<int> adminIndices(ne);
+        for (int i = 0; i < voterCount; i++) {
+            std::iota(adminIndices.begin(), adminIndices.end(), 0);
+            std::shuffle(adminIndices.begin(), adminIndices.end(), rng);
+            adminSets[i].assign(adminIndices.begin(), adminIndices.begin() + t);
+        }
+        
+        ChainReport chain = runVoterChains(params, keyOut, dids, adminSets);
+        if (chain.verified != (size_t)voterCount) {
+            throw std::runtime_error("Verification failed: " + std::to_string(voterCount - (int)chain.verified) + " show(s) rejected (duplicate, pairing or KoR)");
+        }
+        
+        auto programEnd = Clock::now();
+        auto totalDuration = std::chrono::duration_cast<std::chrono::microseconds>(programEnd - programStart).count();
+        
+        std::cout << "=== Zaman Olcumleri (ms) - chain ===\n";
+        std::cout << "Setup suresi       : " << setup_us / 1000.0  << " ms\n";
+        std::cout << "Pairing suresi     : " << pairing_us / 1000.0 << " ms\n";
+        std::cout << "KeyGen suresi      : " << keygen_us / 1000.0 << " ms\n";
+        std::cout << "ID Generation      : " << idGen_us / 1000.0  << " ms\n";
+        std::cout << "DID Generation     : " << didGen_us / 1000.0 << " ms\n";
+        std::cout << "-- asama basina toplam CPU zamani (tum isciler) --\n";
+        std::cout << "Prepare Phase      : " << chain.times.prep_us / 1000.0      << " ms\n";
+        std::cout << "BlindSign Phase    : " << chain.times.blind_us / 1000.0     << " ms\n";
+        std::cout << "Unblind Phase      : " << chain.times.unblind_us / 1000.0   << " ms\n";
+        std::cout << "Aggregate Phase    : " << chain.times.aggregate_us / 1000.0 << " ms\n";
+        std::cout << "ProveCredential    : " << chain.times.prove_us / 1000.0     << " ms\n";
+        std::cout << "KoR Generation     : " << chain.times.kor_us / 1000.0       << " ms\n";
+        std::cout << "Total Verification : " << chain.times.verify_us / 1000.0    << " ms\n";
+        std::cout << "-- zincir --\n";
+        std::cout << "Chain wall time    : " << chain.wall_us / 1000.0 << " ms\n";
+        std::cout << "Voter latency mean : " << chain.latencyMean_us / 1000.0 << " ms\n";
+        std::cout << "Voter latency p50  : " << chain.latencyP50_us / 1000.0 << " ms\n";
+        std::cout << "Voter latency p99  : " << chain.latencyP99_us / 1000.0 << " ms\n";
+        std::cout << "Voter latency max  : " << chain.latencyMax_us / 1000.0 << " ms\n";
+        std::cout << "Total execution    : " << totalDuration / 1000.0 << " ms\n";
+        std::cout << "\n=== Program Sonu ===\n";
+        return 0;
+    }
+    
     std::vector<PipelineResult> pipelineResults(voterCount);
     auto pipelineStart = Clock::now();
     
     // Prepare BlindSign işlemleri - süre ölçümü for döngüsü dışında
     auto prepStart = Clock::now();
     std::vector<PrepareBlindSignOutput> preparedOutputs(voterCount);
+    // Deterministik modda her (asama, secmen) ciftinin kendi rastgelelik akisi var
     tbb::parallel_for(0, voterCount, [&](int i){
+        RandomStreamScope stream((uint64_t)i);
+        TRACE_SPAN("prepare", i);
         preparedOutputs[i] = prepareBlindSign(params, dids[i].did);
     });
     auto prepEnd = Clock::now();
@@ -128,8 +234,7 @@ tbb::global_control gc(tbb::global_control::max_allowed_parallelism, max_threads
     };
     std::vector<SignTask> tasks;
     tasks.reserve(voterCount * t);
-    std::random_device rd;
-    std::mt19937 rng(rd());
+    std::mt19937 rng(randomU64());
     
     for (int i = 0; i < voterCount; i++) {
         pipelineResults[i].signatures.resize(t);
@@ -154,15 +259,8 @@ tbb::global_control gc(tbb::global_control::max_allowed_parallelism, max_threads
         int j = st.indexInVoter;
         int aId = st.adminId;
         
-        mpz_t xm, ym;
-        mpz_init(xm);
-        mpz_init(ym);
-        element_to_mpz(xm, keyOut.eaKeys[aId].sgk1);
-        element_to_mpz(ym, keyOut.eaKeys[aId].sgk2);
-        BlindSignature sig = blindSign(params, preparedOutputs[vId], xm, ym, aId, vId);
-        mpz_clear(xm);
-        mpz_clear(ym);
-        pipelineResults[vId].signatures[j] = sig;
+        TRACE_SPAN("sign", vId);
+        pipelineResults[vId].signatures[j] = blindSign(params, preparedOutputs[vId], keyOut.eaKeys[aId].sgk1, keyOut.eaKeys[aId].sgk2, aId, vId);
     });
     auto blindEnd = Clock::now();
     auto blindTime = std::chrono::duration_cast<std::chrono::microseconds>(blindEnd - blindStart).count();
@@ -179,18 +277,16 @@ tbb::global_control gc(tbb::global_control::max_allowed_parallelism, max_threads
     // Unblind işlemleri - süre ölçümü for döngüsü dışında
     auto unblindStart = Clock::now();
     std::vector<std::vector<std::pair<int, UnblindSignature>>> unblindResultsWithAdmin(voterCount);
-    std::vector<std::vector<UnblindSignature>> unblindResults(voterCount);
     
     tbb::parallel_for(0, voterCount, [&](int i) {
         int numSigs = (int) pipelineResults[i].signatures.size();
-        unblindResults[i].resize(numSigs);
         unblindResultsWithAdmin[i].resize(numSigs);
         
         tbb::parallel_for(0, numSigs, [&](int j) {
             int adminId = pipelineResults[i].signatures[j].adminId; 
-            UnblindSignature usig = unblindSign(params, preparedOutputs[i], pipelineResults[i].signatures[j], keyOut.eaKeys[adminId], dids[i].did);
-            unblindResults[i][j] = usig;
-            unblindResultsWithAdmin[i][j] = {adminId, usig};
+            TRACE_SPAN("unblind", i);
+            UnblindSignature usig = unblindSign(params, preparedOutputs[i], pipelineResults[i].signatures[j], keyOut.eaKeys[adminId]);
+            unblindResultsWithAdmin[i][j] = {adminId, std::move(usig)};
         });
     });
     auto unblindEnd = Clock::now();
@@ -208,8 +304,8 @@ tbb::global_control gc(tbb::global_control::max_allowed_parallelism, max_threads
     auto aggregateStart = Clock::now();
     
     tbb::parallel_for(0, voterCount, [&](int i) {
-        AggregateSignature aggSig = aggregateSign(params, unblindResultsWithAdmin[i], keyOut.mvk, dids[i].did, params.prime_order);
-        aggregateResults[i] = aggSig;
+        TRACE_SPAN("aggregate", i);
+        aggregateResults[i] = aggregateSign(params, unblindResultsWithAdmin[i], keyOut.mvk, dids[i].did, params.prime_order);
     });
     
     auto aggregateEnd = Clock::now();
@@ -220,8 +316,9 @@ tbb::global_control gc(tbb::global_control::max_allowed_parallelism, max_threads
     auto proveStart = Clock::now();
     
     tbb::parallel_for(0, voterCount, [&](int i) {
-        ProveCredentialOutput pOut = proveCredential(params, aggregateResults[i], keyOut.mvk, dids[i].did, preparedOutputs[i].o);
-        proveResults[i] = pOut;
+        RandomStreamScope stream((uint64_t)voterCount + i);
+        TRACE_SPAN("prove", i);
+        proveResults[i] = proveCredential(params, aggregateResults[i], keyOut.mvk, preparedOutputs[i].did, preparedOutputs[i].o);
     });
     
     auto proveEnd = Clock::now();
@@ -233,30 +330,15 @@ tbb::global_control gc(tbb::global_control::max_allowed_parallelism, max_threads
     tbb::parallel_for(tbb::blocked_range<int>(0, voterCount),
         [&](const tbb::blocked_range<int>& r) {
             for (int i = r.begin(); i != r.end(); ++i) {
-                mpz_t did_int;
-                mpz_init(did_int);
-                mpz_set_str(did_int, dids[i].did.c_str(), 16);
-                mpz_mod(did_int, did_int, params.prime_order);
-                
-                element_t com_elem;
-                element_init_G1(com_elem, params.pairing);
-                try {
-                    stringToElement(com_elem, preparedOutputs[i].com_str, params.pairing, 1);
-                } catch (const std::exception& e) {
-                    std::cerr << "Error converting com string to element: " << e.what() << std::endl;
-                    element_random(com_elem);
-                }
-                
+                RandomStreamScope stream(2 * (uint64_t)voterCount + i);
+                TRACE_SPAN("KoR", i);
                 KnowledgeOfRepProof korProof = generateKoRProof(
                     params,
-                    aggregateResults[i].h,
+                    preparedOutputs[i],
                     proveResults[i].k,
                     proveResults[i].r,
-                    com_elem,
                     keyOut.mvk.alpha2,
-                    keyOut.mvk.beta2,
-                    did_int,
-                    preparedOutputs[i].o
+                    keyOut.mvk.beta2
                 );
                 
                 element_set(proveResults[i].c, korProof.c);
@@ -264,13 +346,6 @@ tbb::global_control gc(tbb::global_control::max_allowed_parallelism, max_threads
                 element_set(proveResults[i].s2, korProof.s2);
                 element_set(proveResults[i].s3, korProof.s3);
                 proveResults[i].proof_v = korProof.proof_string;
-                
-                element_clear(com_elem);
-                element_clear(korProof.c);
-                element_clear(korProof.s1);
-                element_clear(korProof.s2);
-                element_clear(korProof.s3);
-                mpz_clear(did_int);
             }
         }
     );
@@ -285,6 +360,7 @@ tbb::global_control gc(tbb::global_control::max_allowed_parallelism, max_threads
     tbb::parallel_for(tbb::blocked_range<int>(0, voterCount),
         [&](const tbb::blocked_range<int>& r) {
             for (int i = r.begin(); i != r.end(); ++i) {
+                TRACE_SPAN("pairingCheck", i);
                 bool pairing_ok = pairingCheck(params, proveResults[i]);
                 if (!pairing_ok) {
                     allPairingVerified.store(false);
@@ -303,6 +379,7 @@ tbb::global_control gc(tbb::global_control::max_allowed_parallelism, max_threads
     tbb::parallel_for(tbb::blocked_range<int>(0, voterCount),
         [&](const tbb::blocked_range<int>& r) {
             for (int i = r.begin(); i != r.end(); ++i) {
+                TRACE_SPAN("KoRVerify", i);
                 bool kor_ok = checkKoRVerify(
                     params,
                     proveResults[i],
@@ -327,6 +404,7 @@ tbb::global_control gc(tbb::global_control::max_allowed_parallelism, max_threads
     tbb::parallel_for(tbb::blocked_range<int>(0, voterCount),
         [&](const tbb::blocked_range<int>& r) {
             for (int i = r.begin(); i != r.end(); ++i) {
+                TRACE_SPAN("verify", i);
                 bool pairing_ok = pairingCheck(params, proveResults[i]);
                 bool kor_ok = checkKoRVerify(
                     params,
@@ -351,24 +429,7 @@ tbb::global_control gc(tbb::global_control::max_allowed_parallelism, max_threads
         throw std::runtime_error("Verification failed: pairing check or KoR verification returned false");
     }
     
-    // Kaynakları temizle
-    element_clear(keyOut.mvk.alpha2);
-    element_clear(keyOut.mvk.beta2);
-    element_clear(keyOut.mvk.beta1);
-    
-    for (int i = 0; i < ne; i++) {
-        element_clear(keyOut.eaKeys[i].sgk1);
-        element_clear(keyOut.eaKeys[i].sgk2);
-        element_clear(keyOut.eaKeys[i].vkm1);
-        element_clear(keyOut.eaKeys[i].vkm2);
-        element_clear(keyOut.eaKeys[i].vkm3);
-    }
-    
-    for (int i = 0; i < voterCount; i++) {
-        mpz_clear(dids[i].x);
-    }
-    
-    clearParams(params);
+    // Kaynaklar RAII ile temizlenir; pairing paramsGuard ile en son
     
     auto programEnd = Clock::now();
     auto totalDuration = std::chrono::duration_cast<std::chrono::microseconds>(programEnd - programStart).count();
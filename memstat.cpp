@@ -0,0 +1,40 @@
+#include "memstat.h"
+#include <fstream>
+#include <string>
+#include <sys/resource.h>
+
+static long readStatusKb(const char *key) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    std::string prefix = std::string(key) + ":";
+    while (std::getline(status, line)) {
+        if (line.rfind(prefix, 0) == 0) {
+            return std::stol(line.substr(prefix.size()));
+        }
+    }
+    return -1;
+}
+
+long peakRssKb() {
+    long kb = readStatusKb("VmHWM");
+    if (kb < 0) {
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        kb = usage.ru_maxrss;
+    }
+    return kb;
+}
+
+long currentRssKb() {
+    return readStatusKb("VmRSS");
+}
+
+bool resetPeakRss() {
+    std::ofstream refs("/proc/self/clear_refs");
+    if (!refs) {
+        return false;
+    }
+    refs << "5";
+    refs.flush();
+    return (bool)refs;
+}
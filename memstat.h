@@ -0,0 +1,14 @@
+#ifndef MEMSTAT_H
+#define MEMSTAT_H
+
+// /proc/self/status'tan VmHWM (tepe) ve VmRSS (anlik), KB cinsinden.
+// /proc okunamazsa getrusage ru_maxrss'e duser.
+long peakRssKb();
+long currentRssKb();
+
+// VmHWM'yi o anki RSS'e indirir (/proc/self/clear_refs'e "5"). Bir sonraki
+// peakRssKb() yalnizca bu noktadan sonraki tepeyi verir. Desteklenmiyorsa
+// false doner ve tepe surecin basindan itibaren olculmeye devam eder.
+bool resetPeakRss();
+
+#endif
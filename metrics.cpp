@@ -0,0 +1,277 @@
+#include "metrics.h"
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+unsigned metricsdetail::threadShard() {
+    static std::atomic<unsigned> next(0);
+    thread_local unsigned shard = next.fetch_add(1, std::memory_order_relaxed) % kShards;
+    return shard;
+}
+
+uint64_t MetricCounter::value() const {
+    uint64_t sum = 0;
+    for (const auto &c : cells_) {
+        sum += c.v.load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+void MetricHistogram::observeNs(uint64_t ns) {
+    // le = 2^b us <=> ceil(ns / 1000) <= 2^b
+    uint64_t us = (ns + 999) / 1000;
+    int b = us <= 1 ? 0 : 64 - __builtin_clzll(us - 1);
+    if (b > kBuckets - 1) {
+        b = kBuckets - 1;
+    }
+    Shard &s = shards_[metricsdetail::threadShard()];
+    s.buckets[b].fetch_add(1, std::memory_order_relaxed);
+    s.sumNs.fetch_add(ns, std::memory_order_relaxed);
+}
+
+uint64_t MetricHistogram::bucketCount(int b) const {
+    uint64_t sum = 0;
+    for (const auto &s : shards_) {
+        sum += s.buckets[b].load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+uint64_t MetricHistogram::count() const {
+    uint64_t sum = 0;
+    for (int b = 0; b < kBuckets; b++) {
+        sum += bucketCount(b);
+    }
+    return sum;
+}
+
+double MetricHistogram::sumSeconds() const {
+    uint64_t sum = 0;
+    for (const auto &s : shards_) {
+        sum += s.sumNs.load(std::memory_order_relaxed);
+    }
+    return sum / 1e9;
+}
+
+namespace {
+
+enum class MetricType { Counter, Gauge, Histogram };
+
+struct Series {
+    MetricLabels labels;
+    std::unique_ptr<MetricCounter> counter;
+    std::unique_ptr<MetricGauge> gauge;
+    std::unique_ptr<MetricHistogram> histogram;
+};
+
+struct Family {
+    std::string name;
+    std::string help;
+    MetricType type;
+    std::vector<std::unique_ptr<Series>> series;
+};
+
+std::mutex registryMutex;
+std::vector<std::unique_ptr<Family>> &families() {
+    static std::vector<std::unique_ptr<Family>> all;
+    return all;
+}
+
+Series &findOrAdd(const std::string &name, const std::string &help, MetricType type, const MetricLabels &labels) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    Family *fam = nullptr;
+    for (auto &f : families()) {
+        if (f->name == name) {
+            fam = f.get();
+            break;
+        }
+    }
+    if (!fam) {
+        families().emplace_back(new Family{name, help, type, {}});
+        fam = families().back().get();
+    } else if (fam->type != type) {
+        throw std::runtime_error("metrics: '" + name + "' already registered with another type");
+    }
+    for (auto &s : fam->series) {
+        if (s->labels == labels) {
+            return *s;
+        }
+    }
+    std::unique_ptr<Series> s(new Series);
+    s->labels = labels;
+    switch (type) {
+    case MetricType::Counter: s->counter.reset(new MetricCounter); break;
+    case MetricType::Gauge: s->gauge.reset(new MetricGauge); break;
+    case MetricType::Histogram: s->histogram.reset(new MetricHistogram); break;
+    }
+    fam->series.push_back(std::move(s));
+    return *fam->series.back();
+}
+
+void writeLabels(std::ostream &os, const MetricLabels &labels, const char *extraKey = nullptr, const std::string &extraValue = "") {
+    if (labels.empty() && !extraKey) {
+        return;
+    }
+    os << '{';
+    bool first = true;
+    auto one = [&](const std::string &k, const std::string &v) {
+        if (!first) os << ',';
+        first = false;
+        os << k << "=\"";
+        for (char c : v) {
+            if (c == '\\' || c == '"') os << '\\' << c;
+            else if (c == '\n') os << "\\n";
+            else os << c;
+        }
+        os << '"';
+    };
+    for (const auto &kv : labels) {
+        one(kv.first, kv.second);
+    }
+    if (extraKey) {
+        one(extraKey, extraValue);
+    }
+    os << '}';
+}
+
+bool writeAll(int fd, const std::string &data) {
+    size_t off = 0;
+    while (off < data.size()) {
+        ssize_t w = send(fd, data.data() + off, data.size() - off, MSG_NOSIGNAL);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        off += (size_t)w;
+    }
+    return true;
+}
+
+}
+
+MetricCounter &metricCounter(const std::string &name, const std::string &help, const MetricLabels &labels) {
+    return *findOrAdd(name, help, MetricType::Counter, labels).counter;
+}
+
+MetricGauge &metricGauge(const std::string &name, const std::string &help, const MetricLabels &labels) {
+    return *findOrAdd(name, help, MetricType::Gauge, labels).gauge;
+}
+
+MetricHistogram &metricHistogram(const std::string &name, const std::string &help, const MetricLabels &labels) {
+    return *findOrAdd(name, help, MetricType::Histogram, labels).histogram;
+}
+
+std::string renderMetrics() {
+    std::ostringstream os;
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (const auto &f : families()) {
+        os << "# HELP " << f->name << ' ' << f->help << '\n';
+        os << "# TYPE " << f->name << ' '
+           << (f->type == MetricType::Counter ? "counter" : f->type == MetricType::Gauge ? "gauge" : "histogram") << '\n';
+        for (const auto &s : f->series) {
+            if (f->type == MetricType::Counter) {
+                os << f->name;
+                writeLabels(os, s->labels);
+                os << ' ' << s->counter->value() << '\n';
+            } else if (f->type == MetricType::Gauge) {
+                os << f->name;
+                writeLabels(os, s->labels);
+                os << ' ' << s->gauge->value() << '\n';
+            } else {
+                const MetricHistogram &h = *s->histogram;
+                uint64_t cumulative = 0;
+                for (int b = 0; b < MetricHistogram::kBuckets; b++) {
+                    cumulative += h.bucketCount(b);
+                    std::string le;
+                    if (b == MetricHistogram::kBuckets - 1) {
+                        le = "+Inf";
+                    } else {
+                        std::ostringstream bound;
+                        bound << (double)(1ULL << b) / 1e6;
+                        le = bound.str();
+                    }
+                    os << f->name << "_bucket";
+                    writeLabels(os, s->labels, "le", le);
+                    os << ' ' << cumulative << '\n';
+                }
+                os << f->name << "_sum";
+                writeLabels(os, s->labels);
+                os << ' ' << h.sumSeconds() << '\n';
+                os << f->name << "_count";
+                writeLabels(os, s->labels);
+                os << ' ' << cumulative << '\n';
+            }
+        }
+    }
+    return os.str();
+}
+
+MetricsServer::MetricsServer(int port) : listenFd_(-1), stop_(false) {
+    listenFd_ = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFd_ < 0) {
+        throw std::runtime_error(std::string("MetricsServer: socket: ") + std::strerror(errno));
+    }
+    int one = 1;
+    setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(listenFd_, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(listenFd_, 16) < 0) {
+        int err = errno;
+        close(listenFd_);
+        throw std::runtime_error("MetricsServer: port " + std::to_string(port) + ": " + std::strerror(err));
+    }
+    thread_ = std::thread(&MetricsServer::loop, this);
+}
+
+MetricsServer::~MetricsServer() {
+    stop_.store(true);
+    thread_.join();
+    close(listenFd_);
+}
+
+// Tek is parcacigi, istek basina bir baglanti (HTTP/1.0): scrape araligi
+// saniyeler mertebesinde oldugu icin yeterli.
+void MetricsServer::loop() {
+    while (!stop_.load()) {
+        pollfd p{listenFd_, POLLIN, 0};
+        if (poll(&p, 1, 200) <= 0) {
+            continue;
+        }
+        int fd = accept4(listenFd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            continue;
+        }
+        timeval tv{1, 0};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        std::string request;
+        char buf[1024];
+        while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192) {
+            ssize_t r = recv(fd, buf, sizeof(buf), 0);
+            if (r <= 0) {
+                break;
+            }
+            request.append(buf, (size_t)r);
+        }
+        std::string response;
+        if (request.rfind("GET /metrics", 0) == 0 || request.rfind("GET / ", 0) == 0) {
+            std::string body = renderMetrics();
+            response = "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: "
+                     + std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+        } else {
+            response = "HTTP/1.0 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        }
+        writeAll(fd, response);
+        close(fd);
+    }
+}
@@ -0,0 +1,99 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Uzun sure calisan servisler icin calisma zamani metrikleri. Kayit (isim +
+// etiketler) soguk yoldadir ve kilitlidir; donen referans program boyunca
+// gecerlidir. Sicak yol kilitsizdir: sayac ve histogram is parcacigi basina
+// ayri cache satirina (shard) relaxed fetch_add yapar, gauge tek atomic.
+// Okuyucu (HTTP is parcacigi) shard'lari toplar; yazanlari durdurmaz.
+// Hizlar (orn. saniyede pairing kontrolu) Prometheus'ta rate() ile sayactan
+// hesaplanir.
+
+namespace metricsdetail {
+const int kShards = 16;
+struct alignas(64) Cell {
+    std::atomic<uint64_t> v{0};
+};
+unsigned threadShard();
+}
+
+class MetricCounter {
+public:
+    void inc(uint64_t n = 1) {
+        cells_[metricsdetail::threadShard()].v.fetch_add(n, std::memory_order_relaxed);
+    }
+    uint64_t value() const;
+
+private:
+    metricsdetail::Cell cells_[metricsdetail::kShards];
+};
+
+class MetricGauge {
+public:
+    void set(int64_t v) { v_.store(v, std::memory_order_relaxed); }
+    void add(int64_t d) { v_.fetch_add(d, std::memory_order_relaxed); }
+    int64_t value() const { return v_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64_t> v_{0};
+};
+
+// Kovalar: le = 2^k mikrosaniye (1 us .. ~16.8 s) ve +Inf. Kova indeksi
+// bit sayimiyla bulunur, arama yok.
+class MetricHistogram {
+public:
+    static const int kBuckets = 26;
+
+    void observeNs(uint64_t ns);
+    uint64_t bucketCount(int b) const;
+    uint64_t count() const;
+    double sumSeconds() const;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> buckets[kBuckets];
+        std::atomic<uint64_t> sumNs{0};
+        Shard() {
+            for (auto &b : buckets) b.store(0, std::memory_order_relaxed);
+        }
+    };
+    Shard shards_[metricsdetail::kShards];
+};
+
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+// Ayni isim + etiketler tekrar istenirse ayni nesne doner; ayni isim farkli
+// turde kaydedilirse runtime_error.
+MetricCounter &metricCounter(const std::string &name, const std::string &help, const MetricLabels &labels = {});
+MetricGauge &metricGauge(const std::string &name, const std::string &help, const MetricLabels &labels = {});
+MetricHistogram &metricHistogram(const std::string &name, const std::string &help, const MetricLabels &labels = {});
+
+// Prometheus metin formati (0.0.4)
+std::string renderMetrics();
+
+// 127.0.0.1:port uzerinde arka plan is parcaciginda GET /metrics sunar.
+class MetricsServer {
+public:
+    explicit MetricsServer(int port);
+    ~MetricsServer();
+
+    MetricsServer(const MetricsServer &) = delete;
+    MetricsServer &operator=(const MetricsServer &) = delete;
+
+private:
+    void loop();
+
+    int listenFd_;
+    std::atomic<bool> stop_;
+    std::thread thread_;
+};
+
+#endif
@@ -0,0 +1,281 @@
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <openssl/sha.h>
+#include "setup.h"
+#include "aggregate.h"
+#include "pairinginverify.h"
+#include "latencyhist.h"
+#include "memstat.h"
+#include "rng.h"
+#include "hashmany.h"
+#include "hashtog1.h"
+using Clock = std::chrono::steady_clock;
+
+// Boru hattinin kullandigi her kriptografik ilkel icin mikro benchmark.
+// Her olcum: bench_warmup isinma cagrisi, sonra bench_reps ornek. Ucuz
+// islemler saat cozunurlugunun altinda kalmasin diye bir ornek, ~20 us
+// tutacak kadar ardisik cagriyi kapsar ve cagri basina sure kaydedilir.
+// Girdiler kPool'luk havuzdan donerek secilir (ayni operanda onbellek etkisi
+// olmasin).
+
+namespace {
+
+const int kPool = 64;
+const long long kSampleTargetNs = 20000;
+
+std::string elementHex(element_t elem) {
+    int length = element_length_in_bytes(elem);
+    std::vector<unsigned char> buf(length);
+    element_to_bytes(buf.data(), elem);
+    std::ostringstream oss;
+    oss << std::hex << std::setfill('0');
+    for (auto c : buf) {
+        oss << std::setw(2) << (int)c;
+    }
+    return oss.str();
+}
+
+// prepareblindsign.cpp'deki hashToZr ile ayni yol
+void hashToZr(element_t outZr, TIACParams &params, const std::vector<std::string> &elems) {
+    std::ostringstream oss;
+    for (const auto &s : elems) {
+        oss << s;
+    }
+    std::string msg = oss.str();
+    unsigned char digest[SHA512_DIGEST_LENGTH];
+    SHA512(reinterpret_cast<const unsigned char*>(msg.data()), msg.size(), digest);
+    mpz_t tmp;
+    mpz_init(tmp);
+    mpz_import(tmp, SHA512_DIGEST_LENGTH, 1, 1, 0, 0, digest);
+    mpz_mod(tmp, tmp, params.prime_order);
+    element_set_mpz(outZr, tmp);
+    mpz_clear(tmp);
+}
+
+struct BenchRunner {
+    LatencyRecorder &recorder;
+    int warmup;
+    int reps;
+
+    template <typename Op>
+    void run(const std::string &name, Op op) {
+        auto warmStart = Clock::now();
+        for (int i = 0; i < warmup; i++) {
+            op(i);
+        }
+        long long warmNs = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - warmStart).count();
+        long long perCall = warmup > 0 ? warmNs / warmup : 0;
+        int inner = perCall > 0 ? (int)std::min<long long>(1000, std::max<long long>(1, kSampleTargetNs / perCall)) : 1;
+
+        LatencyHistogram &hist = recorder.op(name);
+        int idx = 0;
+        for (int r = 0; r < reps; r++) {
+            auto start = Clock::now();
+            for (int k = 0; k < inner; k++) {
+                op(idx++);
+            }
+            long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+            hist.record((uint64_t)(ns / inner));
+        }
+
+        std::string label = name;
+        label.resize(22, ' ');
+        std::cout << label << ": mean " << hist.mean() / 1000.0
+                  << "  sd " << hist.stddev() / 1000.0
+                  << "  min " << hist.min() / 1000.0
+                  << "  p50 " << hist.percentile(0.50) / 1000.0
+                  << "  p99 " << hist.percentile(0.99) / 1000.0
+                  << " us  (" << (hist.mean() > 0 ? 1e9 / hist.mean() : 0.0) << " op/s, x" << inner << ")\n";
+    }
+};
+
+}
+
+int main() {
+    int reps = 1000;
+    int warmup = 100;
+    int rbits = 256;
+    int qbits = 512;
+    bool hasSeed = false;
+    uint64_t seed = 0;
+    std::string benchJsonPath;
+    {
+        std::ifstream infile("params.txt");
+        if (!infile) {
+            std::cerr << "Error: params.txt acilamadi!\n";
+            return 1;
+        }
+        std::string line;
+        while (std::getline(infile, line)) {
+            if (line.rfind("bench_reps=", 0) == 0)
+                reps = std::stoi(line.substr(11));
+            else if (line.rfind("bench_warmup=", 0) == 0)
+                warmup = std::stoi(line.substr(13));
+            else if (line.rfind("bench_rbits=", 0) == 0)
+                rbits = std::stoi(line.substr(12));
+            else if (line.rfind("bench_qbits=", 0) == 0)
+                qbits = std::stoi(line.substr(12));
+            else if (line.rfind("bench_json=", 0) == 0)
+                benchJsonPath = line.substr(11);
+            else if (line.rfind("seed=", 0) == 0) {
+                seed = std::stoull(line.substr(5));
+                hasSeed = true;
+            }
+        }
+        infile.close();
+    }
+    if (hasSeed) {
+        installDeterministicRandom(seed);
+    } else {
+        installThreadRandom();
+    }
+
+    auto programStart = Clock::now();
+    TIACParams params = setupParams(rbits, qbits);
+    ParamsGuard paramsGuard{params};
+
+    // Girdi havuzlari
+    std::vector<Element> g1s(kPool), g2s(kPool), gts(kPool), zrs(kPool);
+    std::vector<std::string> g1Hex(kPool);
+    std::vector<std::vector<unsigned char>> g1Bytes(kPool), g1Compressed(kPool);
+    std::vector<Mpz> mpzs(kPool);
+    for (int i = 0; i < kPool; i++) {
+        g1s[i].init(params.pairing, Group::G1);
+        g2s[i].init(params.pairing, Group::G2);
+        gts[i].init(params.pairing, Group::GT);
+        zrs[i].init(params.pairing, Group::Zr);
+        element_random(g1s[i]);
+        element_random(g2s[i]);
+        element_random(zrs[i]);
+        pairing_apply(gts[i], g1s[i], g2s[i], params.pairing);
+        g1Hex[i] = elementHex(g1s[i]);
+        g1Bytes[i].resize(element_length_in_bytes(g1s[i]));
+        element_to_bytes(g1Bytes[i].data(), g1s[i]);
+        g1Compressed[i].resize(element_length_in_bytes_compressed(g1s[i]));
+        element_to_bytes_compressed(g1Compressed[i].data(), g1s[i]);
+        randomMpzModp(mpzs[i], params.prime_order);
+    }
+    Element outG1(params.pairing, Group::G1), outG2(params.pairing, Group::G2);
+    Element outGT(params.pairing, Group::GT), outZr(params.pairing, Group::Zr);
+    Element g1Inv(params.pairing, Group::G1);
+    element_invert(g1Inv, params.g1);
+    Mpz outMpz;
+    Scalar outScalar;
+    std::vector<unsigned char> byteBuf(g1Bytes[0].size());
+    std::vector<int> lagrangeIds = {0, 2, 4};
+
+    LatencyRecorder recorder;
+    BenchRunner bench{recorder, warmup, reps};
+    const size_t g1Len = g1Bytes[0].size();
+
+    std::cout << "=== Mikro Benchmark (r=" << rbits << ", q=" << qbits << ", " << reps
+              << " ornek, " << warmup << " isinma) ===\n";
+
+    bench.run("G1 pow_zn", [&](int i) {
+        element_pow_zn(outG1, g1s[i % kPool], zrs[(i + 1) % kPool]);
+    });
+    bench.run("G2 pow_zn", [&](int i) {
+        element_pow_zn(outG2, g2s[i % kPool], zrs[(i + 1) % kPool]);
+    });
+    bench.run("GT pow_zn", [&](int i) {
+        element_pow_zn(outGT, gts[i % kPool], zrs[(i + 1) % kPool]);
+    });
+    bench.run("G1 mul (CheckKoR)", [&](int i) {
+        element_mul(outG1, g1s[i % kPool], g1s[(i + 1) % kPool]);
+    });
+    bench.run("Zr mul", [&](int i) {
+        element_mul(outZr, zrs[i % kPool], zrs[(i + 1) % kPool]);
+    });
+    bench.run("hashToG1", [&](int i) {
+        hashToG1(params, outG1, g1s[i % kPool]);
+    });
+    // Cagri basina sure, eleman basina degil
+    std::vector<element_s*> hashIns(8), hashOuts(8, (element_s*)outG1);
+    bench.run("hashToG1Batch x8", [&](int i) {
+        for (int j = 0; j < 8; j++) {
+            hashIns[j] = g1s[(i + j) % kPool];
+        }
+        hashToG1Batch(params, hashOuts.data(), hashIns.data(), hashIns.size());
+    });
+    bench.run("element_from_hash G1 (PBC)", [&](int i) {
+        const std::string &s = g1Hex[i % kPool];
+        element_from_hash(outG1, const_cast<char*>(s.data()), (int)s.size());
+    });
+    bench.run("pairing_apply", [&](int i) {
+        pairing_apply(outGT, g1s[i % kPool], g2s[(i + 1) % kPool], params.pairing);
+    });
+    bench.run("pairingProductIsOne x2", [&](int i) {
+        pairingProductIsOne(params, {{params.g1, g2s[i % kPool]}, {g1Inv, g2s[i % kPool]}});
+    });
+    bench.run("element_to_bytes G1", [&](int i) {
+        element_to_bytes(byteBuf.data(), g1s[i % kPool]);
+    });
+    bench.run("element_from_bytes G1", [&](int i) {
+        element_from_bytes(outG1, g1Bytes[i % kPool].data());
+    });
+    bench.run("from_bytes_compressed", [&](int i) {
+        element_from_bytes_compressed(outG1, g1Compressed[i % kPool].data());
+    });
+    bench.run("G1 -> hex string", [&](int i) {
+        std::string s = elementHex(g1s[i % kPool]);
+        byteBuf[0] = (unsigned char)s[0];
+    });
+    bench.run("hashToZr (SHA-512)", [&](int i) {
+        hashToZr(outZr, params, {g1Hex[i % kPool], g1Hex[(i + 1) % kPool], g1Hex[(i + 2) % kPool]});
+    });
+    bench.run("SHA512 (G1 hex)", [&](int i) {
+        unsigned char digest[SHA512_DIGEST_LENGTH];
+        const std::string &s = g1Hex[i % kPool];
+        SHA512(reinterpret_cast<const unsigned char*>(s.data()), s.size(), digest);
+        byteBuf[0] = digest[0];
+    });
+    // Ayni sekiz mesaj tek cagrida; cagri basina sure, mesaj basina degil
+    std::vector<HashMessage> hashBatch(8);
+    unsigned char batchDigests[8 * SHA512_DIGEST_LENGTH];
+    bench.run(std::string("hashMany x8 (") + hashManyEngine() + ")", [&](int i) {
+        for (int j = 0; j < 8; j++) {
+            const std::string &s = g1Hex[(i + j) % kPool];
+            hashBatch[j].data = reinterpret_cast<const unsigned char*>(s.data());
+            hashBatch[j].len = s.size();
+        }
+        hashMany(hashBatch.data(), hashBatch.size(), batchDigests);
+        byteBuf[0] = batchDigests[0];
+    });
+    bench.run("mpz -> Zr", [&](int i) {
+        element_set_mpz(outZr, mpzs[i % kPool]);
+    });
+    bench.run("Zr -> mpz", [&](int i) {
+        element_to_mpz(outMpz, zrs[i % kPool]);
+    });
+    bench.run("mpz_invert mod r", [&](int i) {
+        mpz_invert(outMpz, mpzs[i % kPool], params.prime_order);
+    });
+    bench.run("Lagrange coeff (t=3)", [&](int i) {
+        computeLagrangeCoefficient(outScalar, lagrangeIds, (size_t)(i % 3), params.prime_order);
+    });
+
+    if (!benchJsonPath.empty()) {
+        BenchReport report;
+        report.benchmark = "microbench";
+        report.config = {
+            {"rbits", std::to_string(rbits)},
+            {"qbits", std::to_string(qbits)},
+            {"reps", std::to_string(reps)},
+            {"warmup", std::to_string(warmup)},
+            {"seed", hasSeed ? std::to_string(seed) : "null"},
+            {"g1_bytes", std::to_string(g1Len)}
+        };
+        report.total_ms = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - programStart).count() / 1000.0;
+        report.peakRssKb = peakRssKb();
+        writeBenchJson(benchJsonPath, report, recorder);
+        std::cout << "Benchmark JSON         : " << benchJsonPath << "\n";
+    }
+    std::cout << "\n=== Program Sonu ===\n";
+    return 0;
+}
@@ -0,0 +1,356 @@
+#include "netsim.h"
+#include "simruntime.h"
+#include "didgen.h"
+#include "prepareblindsign.h"
+#include "blindsign.h"
+#include "unblindsign.h"
+#include "aggregate.h"
+#include "rng.h"
+#include "wire.h"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct SignRequest {
+    int voterId;
+};
+
+struct SignResponse {
+    int adminId;
+    BlindSignature sig;
+};
+
+struct VoterState {
+    std::string did;
+    std::unique_ptr<PrepareBlindSignOutput> prepared;
+    bool done = false;
+};
+
+SimTime msToSim(double ms) {
+    return (SimTime)(ms * 1000.0 + 0.5);
+}
+
+class Network {
+public:
+    Network(Simulator &sim, const LinkModel &model, int ne, uint64_t seed)
+        : sim_(sim), model_(model), gen_(seed), freeAt_(2 * ne, 0), lastLost_(2 * ne, false) {}
+
+    // EA a'nin erisim hatti uzerinden gonderir; inbound = secmenden EA'ya
+    template <typename Deliver>
+    void send(int a, bool inbound, size_t bytes, Deliver deliver) {
+        int link = 2 * a + (inbound ? 0 : 1);
+        sent++;
+        double lossProb = model_.loss;
+        if (lastLost_[link]) {
+            lossProb = std::max(lossProb, 1.0 - 1.0 / model_.lossBurst);
+        }
+        bool lost = std::uniform_real_distribution<double>(0.0, 1.0)(gen_) < lossProb;
+        lastLost_[link] = lost;
+        SimTime serialize = (SimTime)((double)bytes * 8.0 / model_.bandwidth_mbps);
+        SimTime start = std::max(sim_.now(), freeAt_[link]);
+        freeAt_[link] = start + serialize;
+        if (lost) {
+            this->lost++;
+            return;
+        }
+        SimTime arrival = freeAt_[link] + msToSim(model_.latency_ms) + jitter();
+        sim_.at(arrival, std::move(deliver));
+    }
+
+    long long sent = 0;
+    long long lost = 0;
+
+private:
+    SimTime jitter() {
+        if (model_.jitter_ms <= 0) {
+            return 0;
+        }
+        double j = 0;
+        switch (model_.jitterDist) {
+        case JitterDist::Uniform:
+            j = std::uniform_real_distribution<double>(0.0, 2.0 * model_.jitter_ms)(gen_);
+            break;
+        case JitterDist::Normal:
+            j = std::normal_distribution<double>(0.0, model_.jitter_ms)(gen_);
+            break;
+        case JitterDist::Exponential:
+            j = std::exponential_distribution<double>(1.0 / model_.jitter_ms)(gen_);
+            break;
+        }
+        SimTime us = msToSim(j);
+        SimTime floor = -msToSim(model_.latency_ms);
+        return us < floor ? floor : us;
+    }
+
+    Simulator &sim_;
+    LinkModel model_;
+    std::mt19937_64 gen_;
+    std::vector<SimTime> freeAt_;
+    std::vector<bool> lastLost_;
+};
+
+struct SimContext {
+    TIACParams &params;
+    KeyGenOutput &keyOut;
+    const NetSimConfig &config;
+    Simulator sim;
+    Network net;
+    std::mt19937_64 gen;
+    std::vector<VoterState> voters;
+    std::vector<std::unique_ptr<Mailbox<SignRequest>>> authInbox;
+    std::vector<std::unique_ptr<Mailbox<SignResponse>>> voterInbox;
+    std::vector<double> latency_ms;
+    std::vector<SimTime> authorityBusy;
+    size_t requestBytes = 0;
+    size_t responseBytes = 0;
+    int nextVoter = 0;
+    int activeWorkers = 0;
+    int failed = 0;
+    SimTime lastDone = 0;
+    long long retransmits = 0;
+    long long batches = 0;
+
+    SimContext(TIACParams &p, KeyGenOutput &k, const NetSimConfig &c)
+        : params(p), keyOut(k), config(c), net(sim, c.link, c.ne, randomU64()), gen(randomU64()) {}
+};
+
+// Gercek islemi calistirir, olculen CPU suresini doner
+template <typename Fn>
+SimTime measured(Fn fn) {
+    auto start = Clock::now();
+    fn();
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+}
+
+SimTask authority(SimContext &ctx, int adminId) {
+    Mailbox<SignRequest> &inbox = *ctx.authInbox[adminId];
+    const NetSimConfig &cfg = ctx.config;
+    std::vector<SignRequest> batch;
+    while (true) {
+        std::optional<SignRequest> first = co_await inbox.recv();
+        if (!first) {
+            break;
+        }
+        batch.clear();
+        batch.push_back(*first);
+        SimTime deadline = ctx.sim.now() + msToSim(cfg.batchWait_ms);
+        while ((int)batch.size() < cfg.batchMax) {
+            std::optional<SignRequest> more = inbox.tryPop();
+            if (!more) {
+                SimTime left = deadline - ctx.sim.now();
+                if (left <= 0 || inbox.closed()) {
+                    break;
+                }
+                more = co_await inbox.recv(left);
+                if (!more) {
+                    break;
+                }
+            }
+            batch.push_back(*more);
+        }
+        ctx.batches++;
+
+        SimTime cost = (SimTime)cfg.dispatchOverhead_us;
+        std::vector<std::pair<int, BlindSignature>> replies;
+        for (const SignRequest &req : batch) {
+            VoterState &voter = ctx.voters[req.voterId];
+            // Secmen bitirdiyse gec kalan tekrar istegi bos yere imzalanmaz
+            if (voter.done) {
+                continue;
+            }
+            BlindSignature sig;
+            cost += measured([&] {
+                sig = blindSign(ctx.params, *voter.prepared, ctx.keyOut.eaKeys[adminId].sgk1, ctx.keyOut.eaKeys[adminId].sgk2, adminId, req.voterId);
+            });
+            replies.emplace_back(req.voterId, std::move(sig));
+        }
+        ctx.authorityBusy[adminId] += cost;
+        co_await ctx.sim.sleep(cost);
+
+        for (auto &reply : replies) {
+            int voterId = reply.first;
+            auto msg = std::make_shared<SignResponse>(SignResponse{adminId, std::move(reply.second)});
+            ctx.net.send(adminId, false, ctx.responseBytes, [&ctx, voterId, msg] {
+                ctx.voterInbox[voterId]->push(std::move(*msg));
+            });
+        }
+    }
+}
+
+void sendRequest(SimContext &ctx, int voterId, int adminId) {
+    ctx.net.send(adminId, true, ctx.requestBytes, [&ctx, voterId, adminId] {
+        ctx.authInbox[adminId]->push(SignRequest{voterId});
+    });
+}
+
+SimTask voterWorker(SimContext &ctx) {
+    const NetSimConfig &cfg = ctx.config;
+    std::uniform_int_distribution<unsigned long long> idDist(10000000000ULL, 99999999999ULL);
+    std::vector<int> adminIndices(cfg.ne);
+    while (ctx.nextVoter < cfg.voterCount) {
+        int v = ctx.nextVoter++;
+        VoterState &voter = ctx.voters[v];
+        Mailbox<SignResponse> &inbox = *ctx.voterInbox[v];
+        SimTime start = ctx.sim.now();
+
+        std::string userId = std::to_string(idDist(ctx.gen));
+        SimTime cost = measured([&] {
+            DID did = createDID(ctx.params, userId);
+            voter.did = did.did;
+            voter.prepared = std::make_unique<PrepareBlindSignOutput>(prepareBlindSign(ctx.params, voter.did));
+        });
+        co_await ctx.sim.sleep(cost);
+
+        std::iota(adminIndices.begin(), adminIndices.end(), 0);
+        std::shuffle(adminIndices.begin(), adminIndices.end(), ctx.gen);
+        std::vector<int> admins(adminIndices.begin(), adminIndices.begin() + cfg.t);
+        for (int a : admins) {
+            sendRequest(ctx, v, a);
+        }
+
+        std::vector<std::optional<BlindSignature>> received(cfg.ne);
+        int have = 0;
+        int retries = 0;
+        bool failed = false;
+        while (have < cfg.t) {
+            std::optional<SignResponse> resp = co_await inbox.recv(msToSim(cfg.timeout_ms));
+            if (!resp) {
+                if (retries == cfg.maxRetries) {
+                    failed = true;
+                    break;
+                }
+                retries++;
+                for (int a : admins) {
+                    if (!received[a]) {
+                        sendRequest(ctx, v, a);
+                        ctx.retransmits++;
+                    }
+                }
+                continue;
+            }
+            if (received[resp->adminId]) {
+                continue;
+            }
+            received[resp->adminId] = std::move(resp->sig);
+            have++;
+        }
+
+        if (!failed) {
+            cost = measured([&] {
+                std::vector<std::pair<int, UnblindSignature>> partials;
+                partials.reserve(cfg.t);
+                for (int a : admins) {
+                    partials.emplace_back(a, unblindSign(ctx.params, *voter.prepared, *received[a], ctx.keyOut.eaKeys[a]));
+                }
+                AggregateSignature agg = aggregateSign(ctx.params, partials, ctx.keyOut.mvk, voter.did, ctx.params.prime_order);
+            });
+            co_await ctx.sim.sleep(cost);
+            ctx.latency_ms.push_back((ctx.sim.now() - start) / 1000.0);
+        } else {
+            ctx.failed++;
+        }
+        voter.done = true;
+        voter.prepared.reset();
+        ctx.lastDone = ctx.sim.now();
+    }
+    // Son isci cikarken EA'lar kapatilir, simulasyon kuyrugu bosalir
+    if (--ctx.activeWorkers == 0) {
+        for (auto &inbox : ctx.authInbox) {
+            inbox->close();
+        }
+    }
+}
+
+double percentile(const std::vector<double> &sorted, int pct) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    return sorted[(sorted.size() - 1) * pct / 100];
+}
+
+}
+
+JitterDist parseJitterDist(const std::string &name) {
+    if (name == "uniform") {
+        return JitterDist::Uniform;
+    }
+    if (name == "normal") {
+        return JitterDist::Normal;
+    }
+    if (name == "exp" || name == "exponential") {
+        return JitterDist::Exponential;
+    }
+    throw std::runtime_error("parseJitterDist: unknown distribution '" + name + "'");
+}
+
+NetSimReport runNetSim(TIACParams &params, KeyGenOutput &keyOut, const NetSimConfig &config) {
+    if (config.t <= 0 || config.t > config.ne) {
+        throw std::runtime_error("runNetSim: threshold must be in [1, ne]");
+    }
+    if (config.concurrency <= 0 || config.batchMax <= 0) {
+        throw std::runtime_error("runNetSim: concurrency and batch size must be positive");
+    }
+    if (config.link.lossBurst < 1.0 || config.link.bandwidth_mbps <= 0) {
+        throw std::runtime_error("runNetSim: invalid link model");
+    }
+
+    SimContext ctx(params, keyOut, config);
+    ctx.voters.resize(config.voterCount);
+    for (int m = 0; m < config.ne; m++) {
+        ctx.authInbox.push_back(std::make_unique<Mailbox<SignRequest>>(ctx.sim));
+    }
+    for (int v = 0; v < config.voterCount; v++) {
+        ctx.voterInbox.push_back(std::make_unique<Mailbox<SignResponse>>(ctx.sim));
+    }
+    ctx.authorityBusy.assign(config.ne, 0);
+
+    // Tel uzerindeki boyutlar wire.h cerceveleriyle ayni
+    WireCodec codec = makeWireCodec(params);
+    ctx.requestBytes = wireFrameSize(codec, WireType::PrepareRequest);
+    ctx.responseBytes = wireFrameSize(codec, WireType::BlindSignature);
+
+    for (int m = 0; m < config.ne; m++) {
+        ctx.sim.spawn(authority(ctx, m));
+    }
+    int workers = std::min(config.concurrency, std::max(config.voterCount, 1));
+    ctx.activeWorkers = workers;
+    for (int w = 0; w < workers; w++) {
+        ctx.sim.spawn(voterWorker(ctx));
+    }
+    ctx.sim.run();
+
+    NetSimReport report;
+    std::vector<double> &lat = ctx.latency_ms;
+    report.issued = (int)lat.size();
+    report.failed = ctx.failed;
+    if (!lat.empty()) {
+        report.latencyMean_ms = std::accumulate(lat.begin(), lat.end(), 0.0) / lat.size();
+        std::sort(lat.begin(), lat.end());
+        report.latencyP50_ms = percentile(lat, 50);
+        report.latencyP90_ms = percentile(lat, 90);
+        report.latencyP99_ms = percentile(lat, 99);
+        report.latencyMax_ms = lat.back();
+    }
+    // Kuyrukta kalan eski zaman asimlari sim.now()'i ilerletir; son secmenin
+    // bitisi esas alinir
+    report.makespan_ms = ctx.lastDone / 1000.0;
+    if (ctx.lastDone > 0) {
+        report.throughput = report.issued / (ctx.lastDone / 1e6);
+        SimTime busy = std::accumulate(ctx.authorityBusy.begin(), ctx.authorityBusy.end(), (SimTime)0);
+        report.authorityBusy = (double)busy / config.ne / ctx.lastDone;
+    }
+    report.messagesSent = ctx.net.sent;
+    report.messagesLost = ctx.net.lost;
+    report.retransmits = ctx.retransmits;
+    report.batches = ctx.batches;
+    return report;
+}
@@ -0,0 +1,63 @@
+#ifndef NETSIM_H
+#define NETSIM_H
+
+#include "setup.h"
+#include "keygen.h"
+#include <string>
+
+enum class JitterDist { Uniform, Normal, Exponential };
+
+// EA erisim hattinin modeli. Gecikme = latency + jitter (dagilima gore,
+// negatif olamaz) + mesaj boyutu / bant genisligi (hat sirali kullanilir).
+// Kayip Gilbert-Elliott: bir kayiptan sonra sonraki mesaj da
+// 1 - 1/lossBurst olasilikla kaybolur (lossBurst = 1 -> bagimsiz kayip).
+struct LinkModel {
+    double latency_ms = 40.0;
+    double jitter_ms = 5.0;
+    JitterDist jitterDist = JitterDist::Normal;
+    double loss = 0.0;
+    double lossBurst = 1.0;
+    double bandwidth_mbps = 100.0;
+};
+
+struct NetSimConfig {
+    int voterCount = 0;
+    int t = 0;
+    int ne = 0;
+    LinkModel link;
+    // Ayni anda ihrac surecinde olan en fazla secmen
+    int concurrency = 64;
+    // EA tarafinda tek seferde islenen en fazla istek ve ilk istekten sonra
+    // ek istek icin beklenecek sure
+    int batchMax = 1;
+    double batchWait_ms = 0.0;
+    // EA'nin her batch icin odedigi sabit maliyet (RPC, syscall vb.)
+    double dispatchOverhead_us = 50.0;
+    double timeout_ms = 1000.0;
+    int maxRetries = 5;
+};
+
+struct NetSimReport {
+    int issued = 0;
+    int failed = 0;
+    double latencyMean_ms = 0;
+    double latencyP50_ms = 0;
+    double latencyP90_ms = 0;
+    double latencyP99_ms = 0;
+    double latencyMax_ms = 0;
+    double makespan_ms = 0;
+    double throughput = 0;    // secmen / sanal saniye
+    long long messagesSent = 0;
+    long long messagesLost = 0;
+    long long retransmits = 0;
+    long long batches = 0;
+    double authorityBusy = 0; // EA basina ortalama doluluk orani
+};
+
+JitterDist parseJitterDist(const std::string &name);
+
+// Secmenler ve EA'lar coroutine olarak simule edilir; kriptografik islemler
+// gercekten calistirilir ve olculen sureleri kadar sanal zaman ilerletilir.
+NetSimReport runNetSim(TIACParams &params, KeyGenOutput &keyOut, const NetSimConfig &config);
+
+#endif
@@ -0,0 +1,98 @@
+#include <iostream>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include "setup.h"
+#include "keygen.h"
+#include "netsim.h"
+#include "rng.h"
+using Clock = std::chrono::steady_clock;
+
+int main() {
+    NetSimConfig config;
+    bool hasSeed = false;
+    uint64_t seed = 0;
+    {
+        std::ifstream infile("params.txt");
+        if (!infile) {
+            std::cerr << "Error: params.txt acilamadi!\n";
+            return 1;
+        }
+        std::string line;
+        while (std::getline(infile, line)) {
+            if (line.rfind("ea=", 0) == 0)
+                config.ne = std::stoi(line.substr(3));
+            else if (line.rfind("threshold=", 0) == 0)
+                config.t = std::stoi(line.substr(10));
+            else if (line.rfind("votercount=", 0) == 0)
+                config.voterCount = std::stoi(line.substr(11));
+            else if (line.rfind("seed=", 0) == 0) {
+                seed = std::stoull(line.substr(5));
+                hasSeed = true;
+            }
+            else if (line.rfind("net_latency_ms=", 0) == 0)
+                config.link.latency_ms = std::stod(line.substr(15));
+            else if (line.rfind("net_jitter_ms=", 0) == 0)
+                config.link.jitter_ms = std::stod(line.substr(14));
+            else if (line.rfind("net_jitter_dist=", 0) == 0)
+                config.link.jitterDist = parseJitterDist(line.substr(16));
+            else if (line.rfind("net_loss=", 0) == 0)
+                config.link.loss = std::stod(line.substr(9));
+            else if (line.rfind("net_loss_burst=", 0) == 0)
+                config.link.lossBurst = std::stod(line.substr(15));
+            else if (line.rfind("net_bandwidth_mbps=", 0) == 0)
+                config.link.bandwidth_mbps = std::stod(line.substr(19));
+            else if (line.rfind("net_concurrency=", 0) == 0)
+                config.concurrency = std::stoi(line.substr(16));
+            else if (line.rfind("net_batch=", 0) == 0)
+                config.batchMax = std::stoi(line.substr(10));
+            else if (line.rfind("net_batch_wait_ms=", 0) == 0)
+                config.batchWait_ms = std::stod(line.substr(18));
+            else if (line.rfind("net_overhead_us=", 0) == 0)
+                config.dispatchOverhead_us = std::stod(line.substr(16));
+            else if (line.rfind("net_timeout_ms=", 0) == 0)
+                config.timeout_ms = std::stod(line.substr(15));
+            else if (line.rfind("net_retries=", 0) == 0)
+                config.maxRetries = std::stoi(line.substr(12));
+        }
+        infile.close();
+    }
+
+    if (hasSeed) {
+        installDeterministicRandom(seed);
+    } else {
+        installThreadRandom();
+    }
+
+    TIACParams params = setupParams();
+    ParamsGuard paramsGuard{params};
+    KeyGenOutput keyOut = keygen(params, config.t, config.ne);
+
+    auto simStart = Clock::now();
+    NetSimReport rep = runNetSim(params, keyOut, config);
+    auto simEnd = Clock::now();
+    auto sim_ms = std::chrono::duration_cast<std::chrono::microseconds>(simEnd - simStart).count() / 1000.0;
+
+    std::cout << "=== Ag Simulasyonu ===\n";
+    std::cout << "EA / Esik / Secmen : " << config.ne << " / " << config.t << " / " << config.voterCount << "\n";
+    std::cout << "Link               : " << config.link.latency_ms << " ms +- " << config.link.jitter_ms
+              << " ms, kayip " << config.link.loss << ", " << config.link.bandwidth_mbps << " Mbit/s\n";
+    std::cout << "Concurrency        : " << config.concurrency << ", batch " << config.batchMax
+              << " (" << config.batchWait_ms << " ms)\n";
+    std::cout << "Issued / Failed    : " << rep.issued << " / " << rep.failed << "\n";
+    std::cout << "Latency mean       : " << rep.latencyMean_ms << " ms\n";
+    std::cout << "Latency p50        : " << rep.latencyP50_ms << " ms\n";
+    std::cout << "Latency p90        : " << rep.latencyP90_ms << " ms\n";
+    std::cout << "Latency p99        : " << rep.latencyP99_ms << " ms\n";
+    std::cout << "Latency max        : " << rep.latencyMax_ms << " ms\n";
+    std::cout << "Makespan (sanal)   : " << rep.makespan_ms << " ms\n";
+    std::cout << "Throughput         : " << rep.throughput << " secmen/s\n";
+    std::cout << "EA doluluk         : " << rep.authorityBusy * 100.0 << " %\n";
+    std::cout << "Mesaj / Kayip      : " << rep.messagesSent << " / " << rep.messagesLost << "\n";
+    std::cout << "Retransmit         : " << rep.retransmits << "\n";
+    std::cout << "EA batch sayisi    : " << rep.batches << "\n";
+    std::cout << "Simulasyon suresi  : " << sim_ms << " ms (gercek)\n";
+    std::cout << "\n=== Program Sonu ===\n";
+
+    return 0;
+}
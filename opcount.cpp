@@ -0,0 +1,171 @@
+#include "opcount.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+OpCounts &OpCounts::operator+=(const OpCounts &o) {
+    millerLoops += o.millerLoops;
+    finalExps += o.finalExps;
+    expG1 += o.expG1;
+    expG2 += o.expG2;
+    expGT += o.expGT;
+    expZr += o.expZr;
+    hashG1 += o.hashG1;
+    hashZr += o.hashZr;
+    sha512 += o.sha512;
+    sha512Bytes += o.sha512Bytes;
+    elementInits += o.elementInits;
+    mpzInverts += o.mpzInverts;
+    return *this;
+}
+
+OpCounts OpCounts::operator-(const OpCounts &o) const {
+    OpCounts d;
+    d.millerLoops = millerLoops - o.millerLoops;
+    d.finalExps = finalExps - o.finalExps;
+    d.expG1 = expG1 - o.expG1;
+    d.expG2 = expG2 - o.expG2;
+    d.expGT = expGT - o.expGT;
+    d.expZr = expZr - o.expZr;
+    d.hashG1 = hashG1 - o.hashG1;
+    d.hashZr = hashZr - o.hashZr;
+    d.sha512 = sha512 - o.sha512;
+    d.sha512Bytes = sha512Bytes - o.sha512Bytes;
+    d.elementInits = elementInits - o.elementInits;
+    d.mpzInverts = mpzInverts - o.mpzInverts;
+    return d;
+}
+
+#ifdef EVOTING_OPCOUNT
+
+namespace {
+
+field_ptr fieldG1 = nullptr;
+field_ptr fieldG2 = nullptr;
+field_ptr fieldGT = nullptr;
+field_ptr fieldZr = nullptr;
+
+struct StageTotal {
+    std::string name;
+    uint64_t calls = 0;
+    OpCounts ops;
+};
+
+std::mutex stageMutex;
+std::vector<StageTotal> stages;
+
+// Her is parcaciginin sayaci kayitlidir; is parcacigi bitince sayimi
+// retired'a devreder.
+std::mutex threadMutex;
+std::vector<OpCounts*> liveCounts;
+OpCounts retired;
+
+struct ThreadCounts {
+    OpCounts counts;
+    ThreadCounts() {
+        std::lock_guard<std::mutex> lock(threadMutex);
+        liveCounts.push_back(&counts);
+    }
+    ~ThreadCounts() {
+        std::lock_guard<std::mutex> lock(threadMutex);
+        retired += counts;
+        liveCounts.erase(std::find(liveCounts.begin(), liveCounts.end(), &counts));
+    }
+};
+
+}
+
+void opCountRegisterPairing(pairing_ptr pairing) {
+    fieldG1 = pairing->G1;
+    fieldG2 = pairing->G2;
+    fieldGT = pairing->GT;
+    fieldZr = pairing->Zr;
+}
+
+OpCounts &opCountsLocal() {
+    thread_local ThreadCounts local;
+    return local.counts;
+}
+
+OpCounts opCountsAllThreads() {
+    std::lock_guard<std::mutex> lock(threadMutex);
+    OpCounts sum = retired;
+    for (const OpCounts *c : liveCounts) {
+        sum += *c;
+    }
+    return sum;
+}
+
+void opCountExp(element_ptr e) {
+    OpCounts &c = opCountsLocal();
+    if (e->field == fieldG1) {
+        c.expG1++;
+    } else if (e->field == fieldG2) {
+        c.expG2++;
+    } else if (e->field == fieldGT) {
+        c.expGT++;
+    } else {
+        c.expZr++;
+    }
+}
+
+void opCountHash(element_ptr e) {
+    OpCounts &c = opCountsLocal();
+    if (e->field == fieldZr) {
+        c.hashZr++;
+    } else {
+        c.hashG1++;
+    }
+}
+
+OpCountStage::OpCountStage(const char *name, bool allThreads)
+    : name_(name), allThreads_(allThreads), start_(allThreads ? opCountsAllThreads() : opCountsLocal()) {}
+
+OpCountStage::~OpCountStage() {
+    OpCounts delta = (allThreads_ ? opCountsAllThreads() : opCountsLocal()) - start_;
+    std::lock_guard<std::mutex> lock(stageMutex);
+    for (StageTotal &s : stages) {
+        if (s.name == name_) {
+            s.calls++;
+            s.ops += delta;
+            return;
+        }
+    }
+    stages.push_back(StageTotal{name_, 1, delta});
+}
+
+void printOpCountTable(std::ostream &os, long long voters) {
+    std::lock_guard<std::mutex> lock(stageMutex);
+    double n = voters > 0 ? (double)voters : 1.0;
+    os << "=== Islem Sayilari (secmen basina) ===\n";
+    os << std::left << std::setw(19) << "Asama" << std::right
+       << std::setw(7) << "cagri" << std::setw(8) << "miller" << std::setw(8) << "finexp"
+       << std::setw(8) << "expG1" << std::setw(8) << "expG2" << std::setw(8) << "expGT" << std::setw(8) << "expZr"
+       << std::setw(8) << "hashG1" << std::setw(8) << "hashZr" << std::setw(8) << "sha512"
+       << std::setw(8) << "init" << std::setw(8) << "inv" << "\n";
+    OpCounts total;
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << std::fixed << std::setprecision(2);
+    auto row = [&](const std::string &name, double calls, const OpCounts &c) {
+        os << std::left << std::setw(19) << name << std::right
+           << std::setw(7) << calls / n << std::setw(8) << c.millerLoops / n << std::setw(8) << c.finalExps / n
+           << std::setw(8) << c.expG1 / n << std::setw(8) << c.expG2 / n << std::setw(8) << c.expGT / n
+           << std::setw(8) << c.expZr / n << std::setw(8) << c.hashG1 / n << std::setw(8) << c.hashZr / n
+           << std::setw(8) << c.sha512 / n << std::setw(8) << c.elementInits / n << std::setw(8) << c.mpzInverts / n << "\n";
+    };
+    uint64_t calls = 0;
+    for (const StageTotal &s : stages) {
+        row(s.name, (double)s.calls, s.ops);
+        total += s.ops;
+        calls += s.calls;
+    }
+    row("TOPLAM", (double)calls, total);
+    os.flags(flags);
+    os.precision(precision);
+}
+
+#endif
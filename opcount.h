@@ -0,0 +1,99 @@
+#ifndef OPCOUNT_H
+#define OPCOUNT_H
+
+// Kriptografik islem sayaci. -DEVOTING_OPCOUNT ile derlenince asagidaki
+// PBC/GMP/OpenSSL cagrilari makrolarla sarilir ve is parcacigi basina
+// sayaclara yazilir; OPCOUNT_STAGE("ad") kapsami boyunca cagiran is
+// parcaciginda artan sayimlar o asamaya eklenir. TBB ile paralel calisan bir
+// cagriyi tamamen saran kapsam icin OPCOUNT_PARALLEL_STAGE kullanilir: tum
+// is parcaciklarinin toplami alinir, bu yuzden ayni anda baska asama
+// calismamalidir. Bayrak yoksa makrolar bos, maliyet sifir.
+//
+// Basliklar makrolardan once dahil edilmeli ki bildirimler etkilenmesin.
+#include <openssl/sha.h>
+#include <pbc/pbc.h>
+#include <gmp.h>
+#include <cstdint>
+#include <iosfwd>
+
+struct OpCounts {
+    uint64_t millerLoops = 0;   // pairing_apply: 1, element_prod_pairing: n
+    uint64_t finalExps = 0;
+    uint64_t expG1 = 0;         // tip A'da G1 == G2
+    uint64_t expG2 = 0;
+    uint64_t expGT = 0;
+    uint64_t expZr = 0;
+    uint64_t hashG1 = 0;        // hashToG1 / element_from_hash, egri noktasina
+    uint64_t hashZr = 0;
+    uint64_t sha512 = 0;
+    uint64_t sha512Bytes = 0;
+    uint64_t elementInits = 0;
+    uint64_t mpzInverts = 0;
+
+    OpCounts &operator+=(const OpCounts &o);
+    OpCounts operator-(const OpCounts &o) const;
+};
+
+#ifdef EVOTING_OPCOUNT
+
+// Eleman turunu ayirt etmek icin pairing'in alanlari kaydedilir
+void opCountRegisterPairing(pairing_ptr pairing);
+
+OpCounts &opCountsLocal();
+// Yasayan ve sonlanmis tum is parcaciklarinin toplami
+OpCounts opCountsAllThreads();
+void opCountExp(element_ptr e);
+void opCountHash(element_ptr e);
+
+class OpCountStage {
+public:
+    explicit OpCountStage(const char *name, bool allThreads = false);
+    ~OpCountStage();
+
+    OpCountStage(const OpCountStage &) = delete;
+    OpCountStage &operator=(const OpCountStage &) = delete;
+
+private:
+    const char *name_;
+    bool allThreads_;
+    OpCounts start_;
+};
+
+// Asama basina toplamlari voters'a bolup tablo olarak yazar.
+void printOpCountTable(std::ostream &os, long long voters);
+
+#define OPCOUNT_CONCAT2(a, b) a##b
+#define OPCOUNT_CONCAT(a, b) OPCOUNT_CONCAT2(a, b)
+#define OPCOUNT_STAGE(name) OpCountStage OPCOUNT_CONCAT(opCountStage_, __LINE__)(name)
+#define OPCOUNT_PARALLEL_STAGE(name) OpCountStage OPCOUNT_CONCAT(opCountStage_, __LINE__)(name, true)
+#define OPCOUNT_REGISTER_PAIRING(p) opCountRegisterPairing(p)
+#define OPCOUNT_REPORT(os, voters) printOpCountTable(os, voters)
+
+#define pairing_apply(out, in1, in2, p) \
+    (opCountsLocal().millerLoops++, opCountsLocal().finalExps++, pairing_apply(out, in1, in2, p))
+#define element_prod_pairing(out, in1, in2, n) \
+    (opCountsLocal().millerLoops += (uint64_t)(n), opCountsLocal().finalExps++, element_prod_pairing(out, in1, in2, n))
+#define element_pow_zn(x, a, n) (opCountExp(x), element_pow_zn(x, a, n))
+#define element_pow_mpz(x, a, n) (opCountExp(x), element_pow_mpz(x, a, n))
+#define element_pow2_mpz(x, a1, n1, a2, n2) (opCountExp(x), opCountExp(x), element_pow2_mpz(x, a1, n1, a2, n2))
+#define element_from_hash(e, data, len) (opCountHash(e), element_from_hash(e, data, len))
+#define element_init_G1(e, p) (opCountsLocal().elementInits++, element_init_G1(e, p))
+#define element_init_G2(e, p) (opCountsLocal().elementInits++, element_init_G2(e, p))
+#define element_init_GT(e, p) (opCountsLocal().elementInits++, element_init_GT(e, p))
+#define element_init_Zr(e, p) (opCountsLocal().elementInits++, element_init_Zr(e, p))
+#define element_init_same_as(e, e2) (opCountsLocal().elementInits++, element_init_same_as(e, e2))
+#define SHA512(d, n, md) \
+    (opCountsLocal().sha512++, opCountsLocal().sha512Bytes += (uint64_t)(n), SHA512(d, n, md))
+#undef mpz_invert
+#define mpz_invert(r, a, m) (opCountsLocal().mpzInverts++, __gmpz_invert(r, a, m))
+
+#else
+
+#define OPCOUNT_STAGE(name) ((void)0)
+#define OPCOUNT_PARALLEL_STAGE(name) ((void)0)
+#define OPCOUNT_REGISTER_PAIRING(p) ((void)0)
+#define OPCOUNT_REPORT(os, voters) ((void)0)
+
+#endif
+
+#endif
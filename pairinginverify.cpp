@@ -1,30 +1,60 @@
 #include "pairinginverify.h"
+#include "metrics.h"
+#include "scratch.h"
 #include <iostream>
 #include <sstream>
-#include <vector>
 #include <iomanip>
+#include <vector>
 
-extern std::string elementToStringG1(const element_t elem);
-bool pairingCheck(TIACParams &params, ProveCredentialOutput &pOut) {
-    element_t pairing_lhs, pairing_rhs;
-    element_init_GT(pairing_lhs, params.pairing);
-    element_init_GT(pairing_rhs, params.pairing);
-    pairing_apply(pairing_lhs, pOut.sigmaRnd.h, pOut.k, params.pairing);
-    pairing_apply(pairing_rhs, pOut.sigmaRnd.s, params.g2, params.pairing);
-    auto gtToString = [&params](element_t gt_elem) -> std::string {
-        int len = element_length_in_bytes(gt_elem);
-        std::vector<unsigned char> buf(len);
-        element_to_bytes(buf.data(), gt_elem);
-        std::ostringstream oss;
-        oss << std::hex << std::setfill('0');
-        for (auto c : buf)
-            oss << std::setw(2) << (int)c;
-        return oss.str();
-    };
-    std::string lhsStr = gtToString(pairing_lhs);
-    std::string rhsStr = gtToString(pairing_rhs);
-    bool valid = (element_cmp(pairing_lhs, pairing_rhs) == 0);
-    element_clear(pairing_lhs);
-    element_clear(pairing_rhs);
+// prod e(P_i, Q_i) == 1 kontrolu: Miller loop'lar birlikte biriktirilir,
+// final exponentiation tek sefer yapilir (element_prod_pairing).
+bool pairingProductIsOne(TIACParams &params, const std::pair<element_s*, element_s*> *pairs, size_t count) {
+    if (count == 0) {
+        return true;
+    }
+    element_t stack1[kPairingStackTerms];
+    element_t stack2[kPairingStackTerms];
+    std::vector<element_s> heap1, heap2;
+    element_t *in1 = stack1;
+    element_t *in2 = stack2;
+    if (count > kPairingStackTerms) {
+        heap1.resize(count);
+        heap2.resize(count);
+        in1 = reinterpret_cast<element_t*>(heap1.data());
+        in2 = reinterpret_cast<element_t*>(heap2.data());
+    }
+    for (size_t i = 0; i < count; i++) {
+        in1[i][0] = *pairs[i].first;
+        in2[i][0] = *pairs[i].second;
+    }
+    ScratchFrame scratch(params.pairing);
+    element_s *prod = scratch.gt();
+    element_prod_pairing(prod, in1, in2, (int)count);
+    return element_is1(prod);
+}
+
+bool pairingProductIsOne(TIACParams &params, std::initializer_list<std::pair<element_s*, element_s*>> pairs) {
+    return pairingProductIsOne(params, pairs.begin(), pairs.size());
+}
+
+// e(h'', k) == e(s'', g2)  <=>  e(h'', k) * e(s''^-1, g2) == 1
+bool pairingCheckElements(TIACParams &params, element_t h, element_t s, element_t k) {
+    static MetricCounter &checks = metricCounter("evoting_pairing_checks_total", "Gosterim pairing kontrolleri");
+    static MetricCounter &failures = metricCounter("evoting_pairing_check_failures_total", "Basarisiz gosterim pairing kontrolleri");
+    checks.inc();
+    ScratchFrame scratch(params.pairing);
+    element_s *s_inv = scratch.g1();
+    element_invert(s_inv, s);
+    bool valid = pairingProductIsOne(params, {
+        {h, k},
+        {s_inv, params.g2}
+    });
+    if (!valid) {
+        failures.inc();
+    }
     return valid;
 }
+
+bool pairingCheck(TIACParams &params, ProveCredentialOutput &pOut) {
+    return pairingCheckElements(params, pOut.sigmaRnd.h, pOut.sigmaRnd.s, pOut.k);
+}
@@ -3,6 +3,27 @@
 
 #include "setup.h"
 #include "provecredential.h"
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+
+// Bu kadar cifte kadar girdiler yigindaki dizilere kopyalanir (cagri basina
+// heap ayirmasi yok); daha uzun listeler icin vector'e dusulur
+const size_t kPairingStackTerms = 4;
+
+// prod e(P_i, Q_i) == 1; herhangi sayida (G1, G2) cifti
+bool pairingProductIsOne(
+    TIACParams &params,
+    const std::pair<element_s*, element_s*> *pairs,
+    size_t count
+);
+
+bool pairingProductIsOne(
+    TIACParams &params,
+    std::initializer_list<std::pair<element_s*, element_s*>> pairs
+);
+
+bool pairingCheckElements(TIACParams &params, element_t h, element_t s, element_t k);
 
 bool pairingCheck(TIACParams &params, ProveCredentialOutput &pOut);
 
@@ -0,0 +1,33 @@
+#include "pbchandle.h"
+
+void Element::init(pairing_t pairing, Group group) {
+    reset();
+    switch (group) {
+        case Group::G1:
+            element_init_G1(e_, pairing);
+            break;
+        case Group::G2:
+            element_init_G2(e_, pairing);
+            break;
+        case Group::GT:
+            element_init_GT(e_, pairing);
+            break;
+        default:
+            element_init_Zr(e_, pairing);
+            break;
+    }
+    live_ = true;
+}
+
+void Element::initSameAs(const Element &other) {
+    reset();
+    element_init_same_as(e_, other.get());
+    live_ = true;
+}
+
+void Element::reset() {
+    if (live_) {
+        element_clear(e_);
+        live_ = false;
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef PBCHANDLE_H
+#define PBCHANDLE_H
+
+#include <pbc/pbc.h>
+#include <gmp.h>
+#include "opcount.h"
+
+enum class Group { G1, G2, GT, Zr };
+
+// element_t sahibi: tasinabilir, kopyalanamaz. Tasima yalnizca
+// {field, data} iki isaretcisini devreder, yeniden ayirma yapmaz.
+// PBC API'si girdiler icin de const olmayan element_t bekledigi icin
+// const nesneden element_s* alinabilir; bu goruntu salt okunur kullanilir.
+class Element {
+public:
+    Element() noexcept : live_(false) {}
+    Element(pairing_t pairing, Group group) : live_(false) { init(pairing, group); }
+    ~Element() { reset(); }
+
+    Element(Element &&other) noexcept : live_(other.live_) {
+        e_[0] = other.e_[0];
+        other.live_ = false;
+    }
+    Element &operator=(Element &&other) noexcept {
+        if (this != &other) {
+            reset();
+            e_[0] = other.e_[0];
+            live_ = other.live_;
+            other.live_ = false;
+        }
+        return *this;
+    }
+    Element(const Element &) = delete;
+    Element &operator=(const Element &) = delete;
+
+    void init(pairing_t pairing, Group group);
+    void initSameAs(const Element &other);
+    void reset();
+
+    bool initialized() const { return live_; }
+    element_s *get() const { return const_cast<element_s*>(e_); }
+    operator element_s*() const { return get(); }
+
+private:
+    element_t e_;
+    bool live_;
+};
+
+// mpz_t sahibi: tasinabilir, kopyalanamaz.
+class Mpz {
+public:
+    Mpz() { mpz_init(v_); }
+    explicit Mpz(mpz_srcptr src) { mpz_init_set(v_, src); }
+    ~Mpz() { mpz_clear(v_); }
+
+    Mpz(Mpz &&other) noexcept {
+        v_[0] = other.v_[0];
+        mpz_init(other.v_);
+    }
+    Mpz &operator=(Mpz &&other) noexcept {
+        if (this != &other) {
+            mpz_swap(v_, other.v_);
+        }
+        return *this;
+    }
+    Mpz(const Mpz &) = delete;
+    Mpz &operator=(const Mpz &) = delete;
+
+    mpz_ptr get() const { return const_cast<mpz_ptr>(v_); }
+    operator mpz_ptr() const { return get(); }
+
+private:
+    mpz_t v_;
+};
+
+#endif
@@ -0,0 +1,327 @@
+#include "perfcount.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <vector>
+#include <tbb/task_scheduler_observer.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+PerfCounts &PerfCounts::operator+=(const PerfCounts &o) {
+    cycles += o.cycles;
+    instructions += o.instructions;
+    llcMisses += o.llcMisses;
+    branchMisses += o.branchMisses;
+    return *this;
+}
+
+PerfCounts PerfCounts::operator-(const PerfCounts &o) const {
+    PerfCounts d;
+    d.cycles = cycles - o.cycles;
+    d.instructions = instructions - o.instructions;
+    d.llcMisses = llcMisses - o.llcMisses;
+    d.branchMisses = branchMisses - o.branchMisses;
+    return d;
+}
+
+namespace {
+
+const int kEvents = 4;  // cycles, instructions, llc, branch
+
+std::atomic<bool> enabled(false);
+// Olay destegi ilk grupta (perfEnable'i cagiran is parcacigi) belirlenir
+bool supported[kEvents] = {false, false, false, false};
+std::string status = "kapali";
+
+struct StageTotal {
+    std::string name;
+    uint64_t calls = 0;
+    int64_t ns = 0;
+    PerfCounts counts;
+};
+
+std::mutex stageMutex;
+std::vector<StageTotal> stages;
+
+int64_t steadyNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#ifdef __linux__
+
+const uint64_t kConfigs[kEvents] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES
+};
+
+int openEvent(uint64_t config, int groupFd) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // perf_event_paranoid=2 altinda da acilabilsin
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.disabled = groupFd < 0 ? 1 : 0;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0);
+}
+
+std::string paranoidLevel() {
+    std::ifstream in("/proc/sys/kernel/perf_event_paranoid");
+    std::string level;
+    if (in >> level) {
+        return "; kernel.perf_event_paranoid=" + level;
+    }
+    return "";
+}
+
+// Her is parcaciginin grubu kayitlidir; is parcacigi bitince son okuma
+// retired'a eklenir.
+struct ThreadGroup;
+std::mutex threadMutex;
+std::vector<ThreadGroup*> liveGroups;
+PerfCounts retired;
+
+struct ThreadGroup {
+    int leader = -1;
+    int fds[kEvents] = {-1, -1, -1, -1};
+    int pos[kEvents] = {-1, -1, -1, -1};  // grup okumasindaki sira
+    int nr = 0;
+
+    // Lider acilamadiysa errno, yoksa 0
+    int open() {
+        leader = openEvent(kConfigs[0], -1);
+        if (leader < 0) {
+            return errno;
+        }
+        fds[0] = leader;
+        pos[0] = nr++;
+        for (int e = 1; e < kEvents; e++) {
+            fds[e] = openEvent(kConfigs[e], leader);
+            if (fds[e] >= 0) {
+                pos[e] = nr++;
+            }
+        }
+        ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        std::lock_guard<std::mutex> lock(threadMutex);
+        liveGroups.push_back(this);
+        return 0;
+    }
+
+    PerfCounts read() const {
+        PerfCounts c;
+        if (leader < 0) {
+            return c;
+        }
+        uint64_t buf[3 + kEvents];
+        if (::read(leader, buf, sizeof(buf)) < (ssize_t)(3 * sizeof(uint64_t))) {
+            return c;
+        }
+        uint64_t timeEnabled = buf[1];
+        uint64_t timeRunning = buf[2];
+        // Coklama: sayac zamanin bir kisminda calistiysa oranla olcekle
+        double scale = (timeRunning > 0 && timeRunning < timeEnabled) ? (double)timeEnabled / timeRunning : 1.0;
+        auto value = [&](int e) -> uint64_t {
+            return pos[e] >= 0 && pos[e] < (int)buf[0] ? (uint64_t)(buf[3 + pos[e]] * scale) : 0;
+        };
+        c.cycles = value(0);
+        c.instructions = value(1);
+        c.llcMisses = value(2);
+        c.branchMisses = value(3);
+        return c;
+    }
+
+    ~ThreadGroup() {
+        if (leader < 0) {
+            return;
+        }
+        PerfCounts last = read();
+        {
+            std::lock_guard<std::mutex> lock(threadMutex);
+            retired += last;
+            liveGroups.erase(std::find(liveGroups.begin(), liveGroups.end(), this));
+        }
+        for (int e = kEvents - 1; e >= 0; e--) {
+            if (fds[e] >= 0) {
+                close(fds[e]);
+            }
+        }
+    }
+};
+
+ThreadGroup &threadGroup(bool &fresh) {
+    thread_local ThreadGroup group;
+    thread_local bool tried = false;
+    fresh = !tried;
+    tried = true;
+    return group;
+}
+
+// Cagiran is parcaciginin grubu (gerekirse acilir)
+ThreadGroup &localGroup() {
+    bool fresh;
+    ThreadGroup &g = threadGroup(fresh);
+    if (fresh) {
+        g.open();
+    }
+    return g;
+}
+
+PerfCounts readLocal() {
+    return localGroup().read();
+}
+
+// TBB iscileri PerfStage cagirmadigindan gruplarini arenaya girerken acar;
+// yoksa readAllThreads yalniz ana thread'i sayar
+class WorkerGroupObserver : public tbb::task_scheduler_observer {
+public:
+    void on_scheduler_entry(bool) override {
+        localGroup();
+    }
+};
+
+PerfCounts readAllThreads() {
+    localGroup();
+    std::lock_guard<std::mutex> lock(threadMutex);
+    PerfCounts sum = retired;
+    for (const ThreadGroup *g : liveGroups) {
+        sum += g->read();
+    }
+    return sum;
+}
+
+#else
+
+PerfCounts readLocal() {
+    return PerfCounts();
+}
+
+PerfCounts readAllThreads() {
+    return PerfCounts();
+}
+
+#endif
+
+}
+
+bool perfEnable() {
+#ifdef __linux__
+    if (enabled.load()) {
+        return true;
+    }
+    bool fresh;
+    ThreadGroup &g = threadGroup(fresh);
+    int err = fresh ? g.open() : (g.leader < 0 ? EACCES : 0);
+    if (err != 0) {
+        status = std::string("perf_event_open: ") + std::strerror(err) + paranoidLevel();
+        return false;
+    }
+    for (int e = 0; e < kEvents; e++) {
+        supported[e] = g.fds[e] >= 0;
+    }
+    status = "acik";
+    enabled.store(true);
+    static WorkerGroupObserver workerObserver;
+    workerObserver.observe(true);
+    return true;
+#else
+    status = "yalniz Linux'ta destekleniyor";
+    return false;
+#endif
+}
+
+bool perfEnabled() {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+std::string perfStatus() {
+    return status;
+}
+
+PerfStage::PerfStage(const char *name, bool allThreads)
+    : name_(name), allThreads_(allThreads), active_(perfEnabled()), startNs_(0) {
+    if (active_) {
+        start_ = allThreads_ ? readAllThreads() : readLocal();
+        startNs_ = steadyNs();
+    }
+}
+
+PerfStage::~PerfStage() {
+    stop();
+}
+
+void PerfStage::stop() {
+    if (!active_) {
+        return;
+    }
+    active_ = false;
+    int64_t ns = steadyNs() - startNs_;
+    PerfCounts delta = (allThreads_ ? readAllThreads() : readLocal()) - start_;
+    std::lock_guard<std::mutex> lock(stageMutex);
+    for (StageTotal &s : stages) {
+        if (s.name == name_) {
+            s.calls++;
+            s.ns += ns;
+            s.counts += delta;
+            return;
+        }
+    }
+    stages.push_back(StageTotal{name_, 1, ns, delta});
+}
+
+void printPerfTable(std::ostream &os) {
+    os << "=== Donanim Sayaclari ===\n";
+    if (!perfEnabled()) {
+        os << "Kullanilamiyor     : " << status << "\n";
+        return;
+    }
+    std::lock_guard<std::mutex> lock(stageMutex);
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << std::left << std::setw(19) << "Asama" << std::right
+       << std::setw(11) << "ms" << std::setw(11) << "Mcycles" << std::setw(11) << "Minstr"
+       << std::setw(7) << "IPC" << std::setw(12) << "LLC/kinstr" << std::setw(12) << "brmis/kinst" << "\n";
+    os << std::fixed;
+    auto cell = [&](int width, int event, double v, int prec) {
+        // Oranlar komut sayisina bolundugu icin instructions da gerekli
+        if (!supported[event] || (event >= 2 && !supported[1])) {
+            os << std::setw(width) << "-";
+        } else {
+            os << std::setw(width) << std::setprecision(prec) << v;
+        }
+    };
+    for (const StageTotal &s : stages) {
+        const PerfCounts &c = s.counts;
+        double kinstr = c.instructions / 1000.0;
+        os << std::left << std::setw(19) << s.name << std::right
+           << std::setw(11) << std::setprecision(2) << s.ns / 1e6;
+        cell(11, 0, c.cycles / 1e6, 2);
+        cell(11, 1, c.instructions / 1e6, 2);
+        if (supported[0] && supported[1] && c.cycles > 0) {
+            os << std::setw(7) << std::setprecision(2) << (double)c.instructions / c.cycles;
+        } else {
+            os << std::setw(7) << "-";
+        }
+        cell(12, 2, kinstr > 0 ? c.llcMisses / kinstr : 0.0, 3);
+        cell(12, 3, kinstr > 0 ? c.branchMisses / kinstr : 0.0, 3);
+        os << "\n";
+    }
+    os.flags(flags);
+    os.precision(precision);
+}
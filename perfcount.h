@@ -0,0 +1,57 @@
+#ifndef PERFCOUNT_H
+#define PERFCOUNT_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+// Linux perf_event_open ile asama basina donanim sayaclari: cycles,
+// instructions, LLC miss (cache-misses) ve branch miss. Her is parcacigi
+// ilk olcumde kendi sayac grubunu acar (pid=0, cpu=-1, yalniz kullanici
+// alani); grup tek read() ile okunur, coklama varsa time_enabled /
+// time_running ile olceklenir. PerfStage baslangic ve bitisteki okumalarin
+// farkini asamaya ekler; allThreads ile tum kayitli is parcaciklari toplanir
+// (TBB ile paralel asamalar icin, ayni anda baska asama calismamali). TBB
+// iscileri gruplarini perfEnable()'dan sonra arenaya ilk giriste acar.
+//
+// perfEnable() cagrilmazsa PerfStage hicbir sey yapmaz. Sayaclar acilamazsa
+// (perf_event_paranoid, konteyner, VM) ya da bir olay desteklenmiyorsa
+// tablo ilgili sutunda "-" gosterir, program devam eder.
+
+struct PerfCounts {
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t llcMisses = 0;
+    uint64_t branchMisses = 0;
+
+    PerfCounts &operator+=(const PerfCounts &o);
+    PerfCounts operator-(const PerfCounts &o) const;
+};
+
+// Cagiran is parcaciginda grubu acmayi dener; false ise neden perfStatus()'ta
+bool perfEnable();
+bool perfEnabled();
+std::string perfStatus();
+
+class PerfStage {
+public:
+    explicit PerfStage(const char *name, bool allThreads = false);
+    ~PerfStage();
+    // Asamayi erken kapatir (kapsam disindaki sure olcumleriyle hizalamak icin)
+    void stop();
+
+    PerfStage(const PerfStage &) = delete;
+    PerfStage &operator=(const PerfStage &) = delete;
+
+private:
+    const char *name_;
+    bool allThreads_;
+    bool active_;
+    int64_t startNs_;
+    PerfCounts start_;
+};
+
+// Asama basina ms, Mcycles, Minstr, IPC, LLC ve branch miss / 1000 komut
+void printPerfTable(std::ostream &os);
+
+#endif
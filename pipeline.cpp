@@ -0,0 +1,165 @@
+#include "pipeline.h"
+#include "didgen.h"
+#include "prepareblindsign.h"
+#include "blindsign.h"
+#include "unblindsign.h"
+#include "aggregate.h"
+#include "provecredential.h"
+#include "kor.h"
+#include "tally.h"
+#include "voterbatch.h"
+#include "doubleshow.h"
+#include "memstat.h"
+#include "rng.h"
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static long long elapsedUs(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+}
+
+StreamingReport runStreamingIssuance(TIACParams &params, KeyGenOutput &keyOut, int voterCount, int t, int ne, int chunkSize) {
+    if (chunkSize <= 0) {
+        throw std::runtime_error("runStreamingIssuance: chunk size must be positive");
+    }
+    StreamingReport report;
+    report.voters = voterCount;
+
+    std::mt19937_64 gen(randomU64());
+    std::uniform_int_distribution<unsigned long long> idDist(10000000000ULL, 99999999999ULL);
+    std::uniform_int_distribution<int> voteDist(0, 1);
+
+    DoubleShowIndex showIndex(voterCount);
+    TallyAccumulator tally;
+    initTally(params, tally);
+
+    for (int base = 0; base < voterCount; base += chunkSize) {
+        int n = std::min(chunkSize, voterCount - base);
+        report.chunks++;
+
+        auto stageStart = Clock::now();
+        std::vector<std::string> userIds(n);
+        for (int i = 0; i < n; i++) {
+            userIds[i] = std::to_string(idDist(gen));
+        }
+        std::vector<DID> dids = createDIDs(params, userIds);
+        report.times.didGen_us += elapsedUs(stageStart);
+
+        stageStart = Clock::now();
+        std::vector<PrepareBlindSignOutput> prepared(n);
+        for (int i = 0; i < n; i++) {
+            prepared[i] = prepareBlindSign(params, dids[i].did);
+        }
+        report.times.prep_us += elapsedUs(stageStart);
+
+        stageStart = Clock::now();
+        std::vector<std::vector<BlindSignature>> blindSigs(n);
+        std::vector<int> adminIndices(ne);
+        for (int i = 0; i < n; i++) {
+            std::iota(adminIndices.begin(), adminIndices.end(), 0);
+            std::shuffle(adminIndices.begin(), adminIndices.end(), gen);
+            blindSigs[i].reserve(t);
+            for (int j = 0; j < t; j++) {
+                int aId = adminIndices[j];
+                blindSigs[i].push_back(blindSign(params, prepared[i], keyOut.eaKeys[aId].sgk1, keyOut.eaKeys[aId].sgk2, aId, base + i));
+            }
+        }
+        report.times.blind_us += elapsedUs(stageStart);
+
+        stageStart = Clock::now();
+        std::vector<std::vector<std::pair<int, UnblindSignature>>> partials(n);
+        for (int i = 0; i < n; i++) {
+            partials[i].reserve(t);
+            for (auto &sig : blindSigs[i]) {
+                int adminId = sig.adminId;
+                partials[i].emplace_back(adminId, unblindSign(params, prepared[i], sig, keyOut.eaKeys[adminId]));
+            }
+            std::vector<BlindSignature>().swap(blindSigs[i]);
+        }
+        report.times.unblind_us += elapsedUs(stageStart);
+
+        stageStart = Clock::now();
+        std::vector<AggregateSignature> aggregates(n);
+        for (int i = 0; i < n; i++) {
+            aggregates[i] = aggregateSign(params, partials[i], keyOut.mvk, dids[i].did, params.prime_order);
+            std::vector<std::pair<int, UnblindSignature>>().swap(partials[i]);
+        }
+        report.times.aggregate_us += elapsedUs(stageStart);
+
+        stageStart = Clock::now();
+        std::vector<ProveCredentialOutput> proofs(n);
+        for (int i = 0; i < n; i++) {
+            proofs[i] = proveCredential(params, aggregates[i], keyOut.mvk, prepared[i].did, prepared[i].o);
+        }
+        report.times.prove_us += elapsedUs(stageStart);
+
+        stageStart = Clock::now();
+        for (int i = 0; i < n; i++) {
+            KnowledgeOfRepProof korProof = generateKoRProof(
+                params,
+                prepared[i],
+                proofs[i].k,
+                proofs[i].r,
+                keyOut.mvk.alpha2,
+                keyOut.mvk.beta2
+            );
+            element_set(proofs[i].c, korProof.c);
+            element_set(proofs[i].s1, korProof.s1);
+            element_set(proofs[i].s2, korProof.s2);
+            element_set(proofs[i].s3, korProof.s3);
+            proofs[i].proof_v = korProof.proof_string;
+        }
+        report.times.kor_us += elapsedUs(stageStart);
+
+        // Dogrulayici sadece sutun tamponunu gorur; struct'lar burada birakilir
+        stageStart = Clock::now();
+        VoterBatch batch;
+        initVoterBatch(params, batch, n);
+        for (int i = 0; i < n; i++) {
+            storeCredential(batch, i, prepared[i], aggregates[i], proofs[i]);
+        }
+        std::vector<PrepareBlindSignOutput>().swap(prepared);
+        std::vector<AggregateSignature>().swap(aggregates);
+        std::vector<ProveCredentialOutput>().swap(proofs);
+        std::vector<DID>().swap(dids);
+        std::vector<char> ok;
+        report.verified += (long long)verifyShowBatch(params, keyOut.mvk, batch, showIndex, ok);
+        report.times.verify_us += elapsedUs(stageStart);
+
+        stageStart = Clock::now();
+        for (int i = 0; i < n; i++) {
+            if (!ok[i]) {
+                continue;
+            }
+            int vote = voteDist(gen);
+            report.expectedTally += vote;
+            Ballot ballot = encryptBallot(params, keyOut.mvk.beta1, vote);
+            storeBallot(batch, i, ballot);
+        }
+        report.times.ballot_us += elapsedUs(stageStart);
+
+        stageStart = Clock::now();
+        accumulateBallots(params, tally, batch, ok);
+        report.times.tally_us += elapsedUs(stageStart);
+    }
+
+    auto stageStart = Clock::now();
+    DlogTable table = buildDlogTable(params, voterCount);
+    std::vector<PartialDecryption> decShares;
+    for (int m = 0; m < t; m++) {
+        decShares.push_back(partialDecrypt(params, tally, keyOut.eaKeys[m], m));
+    }
+    report.tallyResult = decryptTally(params, tally, decShares, table);
+    report.times.tally_us += elapsedUs(stageStart);
+
+    report.peakRssKb = peakRssKb();
+    return report;
+}
@@ -0,0 +1,43 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include "setup.h"
+#include "keygen.h"
+
+struct StageTimes {
+    long long didGen_us = 0;
+    long long prep_us = 0;
+    long long blind_us = 0;
+    long long unblind_us = 0;
+    long long aggregate_us = 0;
+    long long prove_us = 0;
+    long long kor_us = 0;
+    long long verify_us = 0;
+    long long ballot_us = 0;
+    long long tally_us = 0;
+};
+
+struct StreamingReport {
+    StageTimes times;
+    long long voters = 0;
+    long long verified = 0;
+    long long chunks = 0;
+    long long tallyResult = 0;
+    long long expectedTally = 0;
+    long peakRssKb = 0;
+};
+
+// Secmenleri chunkSize'lik parcalar halinde tum asamalardan gecirir.
+// Her parcanin ara sonuclari bir sonraki asama tukettigi anda birakilir;
+// bellek secmen sayisiyla degil parca boyutuyla olceklenir (double-show
+// indeksi ve tally haric).
+StreamingReport runStreamingIssuance(
+    TIACParams &params,
+    KeyGenOutput &keyOut,
+    int voterCount,
+    int t,
+    int ne,
+    int chunkSize
+);
+
+#endif
@@ -1,4 +1,6 @@
 #include "prepareblindsign.h"
+#include "scratch.h"
+#include "hashtog1.h"
 #include <openssl/sha.h>
 #include <vector>
 #include <random>
@@ -7,17 +9,6 @@
 #include <stdexcept>
 #include <iostream>
 
-static void randomZr(element_t zr, TIACParams &params) {
-    element_random(zr);  
-}
-
-static void didStringToMpz(const std::string &didStr, mpz_t rop, const mpz_t p) {
-    if(mpz_set_str(rop, didStr.c_str(), 16) != 0) {
-        throw std::runtime_error("didStringToMpz: invalid hex string");
-    }
-    mpz_mod(rop, rop, p);
-}
-
 static std::string elementToStringG1(element_t elem) {
     int length = element_length_in_bytes(elem);
     std::vector<unsigned char> buf(length);
@@ -30,12 +21,7 @@ static std::string elementToStringG1(element_t elem) {
     return oss.str();
 }
 
-static void hashToG1(element_t outG1, TIACParams &params, element_t inElem) {
-    std::string s = elementToStringG1(inElem); 
-    element_from_hash(outG1, s.data(), s.size());
-}
-
-static void hashToZr(element_t outZr, TIACParams &params, const std::vector<std::string> &elems) {
+static void hashToScalar(Scalar &out, TIACParams &params, const std::vector<std::string> &elems) {
     std::ostringstream oss;
     for (const auto &s : elems) {
         oss << s;
@@ -43,175 +29,79 @@ static void hashToZr(element_t outZr, TIACParams &params, const std::vector<std:
     std::string msg = oss.str();
     unsigned char digest[SHA512_DIGEST_LENGTH];
     SHA512(reinterpret_cast<const unsigned char*>(msg.data()), msg.size(), digest);
-
-    mpz_t tmp;
-    mpz_init(tmp);
-    mpz_import(tmp, SHA512_DIGEST_LENGTH, 1, 1, 0, 0, digest);
-    mpz_mod(tmp, tmp, params.prime_order);
-    element_set_mpz(outZr, tmp);
-    mpz_clear(tmp);
+    scalarFromDigest(out, digest, SHA512_DIGEST_LENGTH, params.prime_order);
 }
+
 static KoRProof computeKoR(
     TIACParams &params,
-    element_t com,   
-    element_t comi,  
-    element_t g1,   
-    element_t h1, 
-    element_t h,   
-    mpz_t oi,        
-    mpz_t did,
-    mpz_t o
+    const PrepareBlindSignOutput &out,
+    element_t g1,
+    element_t h1,
+    const Scalar &oi
 ) {
     KoRProof proof;
 
-    element_t r1, r2, r3;
-    element_init_Zr(r1, params.pairing);
-    element_init_Zr(r2, params.pairing);
-    element_init_Zr(r3, params.pairing);
-    randomZr(r1, params);
-    randomZr(r2, params);
-    randomZr(r3, params);
-
-    element_t comi_prime;
-    element_init_G1(comi_prime, params.pairing);
-    element_t g1_r1, h1_r2;
-    element_init_G1(g1_r1, params.pairing);
-    element_init_G1(h1_r2, params.pairing);
-    element_pow_zn(g1_r1, g1, r1);
-    element_pow_zn(h1_r2, h1, r2);
-    element_mul(comi_prime, g1_r1, h1_r2);
-    element_clear(g1_r1);
-    element_clear(h1_r2);
-
-    element_t com_prime;
-    element_init_G1(com_prime, params.pairing);
-    element_t g1_r3, h_r2;
-    element_init_G1(g1_r3, params.pairing);
-    element_init_G1(h_r2, params.pairing);
-    element_pow_zn(g1_r3, g1, r3);
-    element_pow_zn(h_r2, h, r2);
-    element_mul(com_prime, g1_r3, h_r2);
-    element_clear(g1_r3);
-    element_clear(h_r2);
+    Scalar r1, r2, r3;
+    scalarRandom(r1, params.prime_order);
+    scalarRandom(r2, params.prime_order);
+    scalarRandom(r3, params.prime_order);
 
-    element_init_Zr(proof.c,  params.pairing);
-    element_init_Zr(proof.s1, params.pairing);
-    element_init_Zr(proof.s2, params.pairing);
-    element_init_Zr(proof.s3, params.pairing);
+    // comi' = g1^r1 * h1^r2, com' = g1^r3 * h^r2
+    ScratchFrame scratch(params.pairing);
+    element_s *comi_prime = scratch.g1();
+    scalarPow2(comi_prime, g1, r1, h1, r2);
+    element_s *com_prime = scratch.g1();
+    scalarPow2(com_prime, g1, r3, out.h, r2);
 
     std::vector<std::string> toHash;
     toHash.reserve(7);
     toHash.push_back(elementToStringG1(g1));
-    toHash.push_back(elementToStringG1(h));
+    toHash.push_back(out.h_str);
     toHash.push_back(elementToStringG1(h1));
-    toHash.push_back(elementToStringG1(com));
+    toHash.push_back(out.com_str);
     toHash.push_back(elementToStringG1(com_prime));
-    toHash.push_back(elementToStringG1(comi));
+    toHash.push_back(out.comi_str);
     toHash.push_back(elementToStringG1(comi_prime));
-    hashToZr(proof.c, params, toHash);
+    Scalar c;
+    hashToScalar(c, params, toHash);
 
-    mpz_t c_mpz;
-    mpz_init(c_mpz);
-    element_to_mpz(c_mpz, proof.c);
-    
-    mpz_t r1_mpz, r2_mpz, r3_mpz;
-    mpz_inits(r1_mpz, r2_mpz, r3_mpz, NULL);
-    element_to_mpz(r1_mpz, r1);
-    element_to_mpz(r2_mpz, r2);
-    element_to_mpz(r3_mpz, r3);
-    
-    mpz_t s1_mpz;
-    mpz_init(s1_mpz);
-    mpz_mul(s1_mpz, c_mpz, oi);
-    mpz_sub(s1_mpz, r1_mpz, s1_mpz);
-    mpz_mod(s1_mpz, s1_mpz, params.prime_order);
-    element_set_mpz(proof.s1, s1_mpz);
-    
-    mpz_t s2_mpz;
-    mpz_init(s2_mpz);
-    mpz_mul(s2_mpz, c_mpz, did);
-    mpz_sub(s2_mpz, r2_mpz, s2_mpz);
-    mpz_mod(s2_mpz, s2_mpz, params.prime_order);
-    element_set_mpz(proof.s2, s2_mpz);
-    
-    mpz_t s3_mpz;
-    mpz_init(s3_mpz);
-    mpz_mul(s3_mpz, c_mpz, o);
-    mpz_sub(s3_mpz, r3_mpz, s3_mpz);
-    mpz_mod(s3_mpz, s3_mpz, params.prime_order);
-    element_set_mpz(proof.s3, s3_mpz);
-    
-    mpz_clears(c_mpz, r1_mpz, r2_mpz, r3_mpz, s1_mpz, s2_mpz, s3_mpz, NULL);
-    element_clear(r1);
-    element_clear(r2);
-    element_clear(r3);
-    element_clear(com_prime);
-    element_clear(comi_prime);
-    
+    // s_k = r_k - c * w_k; r_k'lar yerinde yanita donusur
+    scalarResponse(r1, r1, c, oi, params.prime_order);
+    scalarResponse(r2, r2, c, out.did, params.prime_order);
+    scalarResponse(r3, r3, c, out.o, params.prime_order);
+
+    proof.c.init(params.pairing, Group::Zr);
+    proof.s1.init(params.pairing, Group::Zr);
+    proof.s2.init(params.pairing, Group::Zr);
+    proof.s3.init(params.pairing, Group::Zr);
+    scalarToElement(proof.c, c);
+    scalarToElement(proof.s1, r1);
+    scalarToElement(proof.s2, r2);
+    scalarToElement(proof.s3, r3);
     return proof;
 }
 
 PrepareBlindSignOutput prepareBlindSign(TIACParams &params, const std::string &didStr) {
     PrepareBlindSignOutput out;
-    mpz_t oi, o;
-    mpz_inits(oi, o, NULL);
-    element_t tmp;
-    element_init_Zr(tmp, params.pairing);
-    element_random(tmp);
-    element_to_mpz(oi, tmp);
-    element_random(tmp);
-    element_to_mpz(o, tmp);
-    element_clear(tmp);
-    mpz_t didInt;
-    mpz_init(didInt);
-    didStringToMpz(didStr, didInt, params.prime_order);
-    element_init_G1(out.comi, params.pairing);
-    element_t g1_oi, h1_did;
-    element_init_G1(g1_oi, params.pairing);
-    element_init_G1(h1_did, params.pairing);
-    element_t exp;
-    element_init_Zr(exp, params.pairing);
-    element_set_mpz(exp, oi);
-    element_pow_zn(g1_oi, params.g1, exp);
-    element_clear(exp);
-    element_init_Zr(exp, params.pairing);
-    element_set_mpz(exp, didInt);
-    element_pow_zn(h1_did, params.h1, exp);
-    element_clear(exp);
-    element_mul(out.comi, g1_oi, h1_did);
-    element_clear(g1_oi);
-    element_clear(h1_did);
-    element_init_G1(out.h, params.pairing);
-    hashToG1(out.h, params, out.comi);
-    element_init_G1(out.com, params.pairing);
-    element_t g1_o, h_did;
-    element_init_G1(g1_o, params.pairing);
-    element_init_G1(h_did, params.pairing);
-    element_init_Zr(exp, params.pairing);
-    element_set_mpz(exp, o);
-    element_pow_zn(g1_o, params.g1, exp);
-    element_clear(exp);
-    element_init_Zr(exp, params.pairing);
-    element_set_mpz(exp, didInt);
-    element_pow_zn(h_did, out.h, exp);
-    element_clear(exp);
-    element_mul(out.com, g1_o, h_did);
-    element_clear(g1_o);
-    element_clear(h_did);
+    Scalar oi;
+    scalarRandom(oi, params.prime_order);
+    scalarRandom(out.o, params.prime_order);
+    scalarFromHex(out.did, didStr, params.prime_order);
+
+    // comi = g1^oi * h1^did
+    out.comi.init(params.pairing, Group::G1);
+    scalarPow2(out.comi, params.g1, oi, params.h1, out.did);
+    // comi, h ve com'un hex kodlamalari bir kez uretilir; KoR transkripti ve
+    // EA tarafi kontroller ayni dizeleri kullanir. h = Hash(comi) ikili
+    // kodlamadan hesaplanir.
+    out.comi_str = elementToStringG1(out.comi);
+    out.h.init(params.pairing, Group::G1);
+    hashToG1(params, out.h, out.comi);
+    out.h_str = elementToStringG1(out.h);
+    // com = g1^o * h^did
+    out.com.init(params.pairing, Group::G1);
+    scalarPow2(out.com, params.g1, out.o, out.h, out.did);
     out.com_str = elementToStringG1(out.com);
-    out.pi_s = computeKoR(
-        params,
-        out.com,
-        out.comi,
-        params.g1,
-        params.h1,
-        out.h,
-        oi,
-        didInt,
-        o
-    );
-    mpz_init(out.o);
-    mpz_set(out.o, o);
-    mpz_clears(oi, o, didInt, NULL);
+    out.pi_s = computeKoR(params, out, params.g1, params.h1, oi);
     return out;
-}
\ No newline at end of file
+}
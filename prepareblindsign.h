@@ -2,22 +2,29 @@
 #define PREPAREBLINDSIGN_H
 
 #include "setup.h"
+#include "scalar.h"
 #include <string>
 #include <vector>
 
 struct KoRProof {
-    element_t c;
-    element_t s1;
-    element_t s2;
-    element_t s3;
+    Element c;
+    Element s1;
+    Element s2;
+    Element s3;
 };
 
 struct PrepareBlindSignOutput {
-    element_t comi;
-    element_t h;
-    element_t com;
+    Element comi;
+    Element h;
+    Element com;
     KoRProof pi_s;
-    mpz_t o;    
+    Scalar o;
+    Scalar did;    // DID mod r, bir kez cozulur
+    // Kanonik hex kodlamalar (element_to_bytes); prepareBlindSign doldurur,
+    // telden cozulen istekte bos kalir. Yalnizca secmen tarafi (KoR uretimi,
+    // unblind) kullanir; imzalayan EA elemanlari kendisi kodlar.
+    std::string comi_str;
+    std::string h_str;
     std::string com_str; 
 };
 
@@ -8,19 +8,19 @@
 #include <gmp.h>
 
 struct ProveCredentialSigmaRnd {
-    element_t h; 
-    element_t s; 
+    Element h; 
+    Element s; 
     std::string debug_info;
 };
 
 struct ProveCredentialOutput {
     ProveCredentialSigmaRnd sigmaRnd;
-    element_t k;                      
-    element_t r;                     
-    element_t c;
-    element_t s1;
-    element_t s2;
-    element_t s3;
+    Element k;                      
+    Scalar r;                       // kanit rastgeleligi, telde tasinmaz
+    Element c;
+    Element s1;
+    Element s2;
+    Element s3;
     std::string proof_v;             
 };
 
@@ -28,8 +28,8 @@ ProveCredentialOutput proveCredential(
     TIACParams &params,
     AggregateSignature &aggSig,
     MasterVerKey &mvk,
-    const std::string &didStr,
-    const mpz_t o   
+    const Scalar &did,
+    const Scalar &o
 );
 
 #endif
\ No newline at end of file
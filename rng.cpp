@@ -0,0 +1,225 @@
+#include "rng.h"
+#include <pbc/pbc.h>
+#include <openssl/sha.h>
+#include <atomic>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+const size_t kBlockBytes = 64;
+const size_t kBufferBlocks = 16;
+
+std::atomic<uint64_t> gGeneration(0);
+std::atomic<bool> gDeterministic(false);
+std::atomic<uint64_t> gSeed(0);
+std::atomic<uint64_t> gNextThread(0);
+
+// Akis alanlari: thread sirasina gore varsayilan akis ve acikca secilen akis
+const uint64_t kDomainThread = 0;
+const uint64_t kDomainStream = 1;
+
+inline uint32_t rotl32(uint32_t v, int n) {
+    return (v << n) | (v >> (32 - n));
+}
+
+#define CHACHA_QR(a, b, c, d) \
+    a += b; d ^= a; d = rotl32(d, 16); \
+    c += d; b ^= c; b = rotl32(b, 12); \
+    a += b; d ^= a; d = rotl32(d, 8);  \
+    c += d; b ^= c; b = rotl32(b, 7);
+
+void chachaBlock(const uint32_t key[8], uint64_t counter, unsigned char out[kBlockBytes]) {
+    uint32_t in[16] = {
+        0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+        key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7],
+        (uint32_t)counter, (uint32_t)(counter >> 32), 0, 0
+    };
+    uint32_t x[16];
+    std::memcpy(x, in, sizeof(x));
+    for (int i = 0; i < 10; i++) {
+        CHACHA_QR(x[0], x[4], x[8],  x[12]);
+        CHACHA_QR(x[1], x[5], x[9],  x[13]);
+        CHACHA_QR(x[2], x[6], x[10], x[14]);
+        CHACHA_QR(x[3], x[7], x[11], x[15]);
+        CHACHA_QR(x[0], x[5], x[10], x[15]);
+        CHACHA_QR(x[1], x[6], x[11], x[12]);
+        CHACHA_QR(x[2], x[7], x[8],  x[13]);
+        CHACHA_QR(x[3], x[4], x[9],  x[14]);
+    }
+    for (int i = 0; i < 16; i++) {
+        uint32_t v = x[i] + in[i];
+        out[4 * i]     = (unsigned char)v;
+        out[4 * i + 1] = (unsigned char)(v >> 8);
+        out[4 * i + 2] = (unsigned char)(v >> 16);
+        out[4 * i + 3] = (unsigned char)(v >> 24);
+    }
+}
+
+#undef CHACHA_QR
+
+struct ThreadRandom {
+    uint32_t key[8];
+    uint64_t counter = 0;
+    unsigned char buf[kBlockBytes * kBufferBlocks];
+    size_t pos = sizeof(buf);
+    uint64_t generation = ~0ULL;
+
+    void keyFromSeed(uint64_t domain, uint64_t id) {
+        unsigned char in[24];
+        uint64_t seed = gSeed.load();
+        for (int i = 0; i < 8; i++) {
+            in[i]      = (unsigned char)(seed >> (8 * i));
+            in[8 + i]  = (unsigned char)(domain >> (8 * i));
+            in[16 + i] = (unsigned char)(id >> (8 * i));
+        }
+        unsigned char digest[SHA512_DIGEST_LENGTH];
+        SHA512(in, sizeof(in), digest);
+        for (int i = 0; i < 8; i++) {
+            key[i] = (uint32_t)digest[4 * i] | ((uint32_t)digest[4 * i + 1] << 8)
+                   | ((uint32_t)digest[4 * i + 2] << 16) | ((uint32_t)digest[4 * i + 3] << 24);
+        }
+        counter = 0;
+        pos = sizeof(buf);
+    }
+
+    void keyFromOs() {
+        std::random_device rd;
+        for (int i = 0; i < 8; i++) {
+            key[i] = rd();
+        }
+        counter = 0;
+        pos = sizeof(buf);
+    }
+
+    void ensureKeyed() {
+        uint64_t gen = gGeneration.load(std::memory_order_acquire);
+        if (generation == gen) {
+            return;
+        }
+        generation = gen;
+        if (gDeterministic.load()) {
+            keyFromSeed(kDomainThread, gNextThread.fetch_add(1));
+        } else {
+            keyFromOs();
+        }
+    }
+
+    void refill() {
+        for (size_t b = 0; b < kBufferBlocks; b++) {
+            chachaBlock(key, counter++, buf + b * kBlockBytes);
+        }
+        pos = 0;
+    }
+
+    void fill(unsigned char *out, size_t len) {
+        ensureKeyed();
+        while (len > 0) {
+            if (pos == sizeof(buf)) {
+                refill();
+            }
+            size_t n = sizeof(buf) - pos;
+            if (n > len) {
+                n = len;
+            }
+            std::memcpy(out, buf + pos, n);
+            // Verilen anahtar akisi tamponda birakilmaz
+            std::memset(buf + pos, 0, n);
+            pos += n;
+            out += n;
+            len -= n;
+        }
+    }
+};
+
+thread_local ThreadRandom tlsRandom;
+
+void pbcRandomHook(mpz_t rop, mpz_t limit, void *) {
+    randomMpzModp(rop, limit);
+}
+
+void install(bool deterministic, uint64_t seed) {
+    gDeterministic.store(deterministic);
+    gSeed.store(seed);
+    gNextThread.store(0);
+    gGeneration.fetch_add(1, std::memory_order_release);
+    pbc_random_set_function(pbcRandomHook, nullptr);
+}
+
+}
+
+void installThreadRandom() {
+    install(false, 0);
+}
+
+void installDeterministicRandom(uint64_t seed) {
+    install(true, seed);
+}
+
+bool randomIsDeterministic() {
+    return gDeterministic.load();
+}
+
+RandomStreamScope::RandomStreamScope(uint64_t streamId) : active_(gDeterministic.load()) {
+    if (!active_) {
+        return;
+    }
+    ThreadRandom &r = tlsRandom;
+    std::memcpy(key_, r.key, sizeof(key_));
+    counter_ = r.counter;
+    pos_ = r.pos;
+    generation_ = r.generation;
+    r.generation = gGeneration.load(std::memory_order_acquire);
+    r.keyFromSeed(kDomainStream, streamId);
+}
+
+RandomStreamScope::~RandomStreamScope() {
+    if (!active_) {
+        return;
+    }
+    // Tampon kopyalanmaz: kalan kisim ayni anahtar ve sayactan yeniden
+    // uretilir, verilmis baytlar pos_ ile atlanir
+    ThreadRandom &r = tlsRandom;
+    std::memcpy(r.key, key_, sizeof(key_));
+    r.generation = generation_;
+    r.counter = counter_;
+    r.pos = sizeof(r.buf);
+    if (pos_ < sizeof(r.buf)) {
+        r.counter -= kBufferBlocks;
+        r.refill();
+        std::memset(r.buf, 0, pos_);
+        r.pos = pos_;
+    }
+}
+
+void randomBytes(unsigned char *out, size_t len) {
+    tlsRandom.fill(out, len);
+}
+
+uint64_t randomU64() {
+    unsigned char b[8];
+    tlsRandom.fill(b, sizeof(b));
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++) {
+        v |= (uint64_t)b[i] << (8 * i);
+    }
+    return v;
+}
+
+void randomMpzModp(mpz_t rop, const mpz_t p) {
+    size_t bits = mpz_sizeinbase(p, 2);
+    size_t bytes = (bits + 7) / 8;
+    unsigned char stackBuf[128];
+    std::vector<unsigned char> heapBuf;
+    unsigned char *buf = stackBuf;
+    if (bytes > sizeof(stackBuf)) {
+        heapBuf.resize(bytes);
+        buf = heapBuf.data();
+    }
+    do {
+        tlsRandom.fill(buf, bytes);
+        mpz_import(rop, bytes, 1, 1, 0, 0, buf);
+        mpz_fdiv_r_2exp(rop, rop, bits);
+    } while (mpz_cmp(rop, p) >= 0);
+}
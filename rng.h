@@ -0,0 +1,50 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <gmp.h>
+#include <cstddef>
+#include <cstdint>
+
+// Thread basina tamponlu ChaCha20 akisi. PBC'nin rastgelelik kancasina
+// (pbc_random_set_function) baglanir, boylece element_random ve
+// pbc_mpz_random da ayni kaynagi kullanir. Her thread kendi anahtar ve
+// tamponuna sahiptir; paralel cagrilar kilitlenmez.
+
+// Her thread OS'tan (std::random_device) anahtarlanir.
+void installThreadRandom();
+
+// Tum akislar seed'den turetilir: ayni seed ile ayni sirada yapilan
+// cagrilar bit bit ayni sonucu verir.
+void installDeterministicRandom(uint64_t seed);
+
+bool randomIsDeterministic();
+
+// Deterministik modda kapsam boyunca cagiran thread'in akisini
+// (seed, streamId)'ye baglar; paralel isler is birimine (ornegin secmen
+// indeksine) gore akis secerek thread atamasindan bagimsiz olarak
+// tekrarlanabilir olur. Kapsam bitince thread'in onceki akisi (anahtar,
+// sayac, konum) geri yuklenir: parallel_for'a katilan ana thread kendi
+// akisina doner. OS modunda no-op.
+class RandomStreamScope {
+public:
+    explicit RandomStreamScope(uint64_t streamId);
+    ~RandomStreamScope();
+
+    RandomStreamScope(const RandomStreamScope &) = delete;
+    RandomStreamScope &operator=(const RandomStreamScope &) = delete;
+
+private:
+    bool active_;
+    uint32_t key_[8];
+    uint64_t counter_;
+    size_t pos_;
+    uint64_t generation_;
+};
+
+void randomBytes(unsigned char *out, size_t len);
+uint64_t randomU64();
+
+// [0, p) araliginda duzgun dagilimli (reddetme ornekleme ile).
+void randomMpzModp(mpz_t rop, const mpz_t p);
+
+#endif
@@ -0,0 +1,57 @@
+#include "scalar.h"
+#include "rng.h"
+#include <stdexcept>
+
+void scalarRandom(Scalar &out, mpz_srcptr order) {
+    randomMpzModp(out, order);
+}
+
+void scalarFromHex(Scalar &out, const std::string &hex, mpz_srcptr order) {
+    if (mpz_set_str(out, hex.c_str(), 16) != 0) {
+        throw std::runtime_error("scalarFromHex: invalid hex string");
+    }
+    mpz_mod(out, out, order);
+}
+
+void scalarFromDigest(Scalar &out, const unsigned char *digest, size_t len, mpz_srcptr order) {
+    mpz_import(out, len, 1, 1, 0, 0, digest);
+    mpz_mod(out, out, order);
+}
+
+void scalarFromElement(Scalar &out, element_t zr) {
+    element_to_mpz(out, zr);
+}
+
+void scalarToElement(element_t zr, const Scalar &s) {
+    element_set_mpz(zr, s);
+}
+
+void scalarSet(Scalar &out, const Scalar &a) {
+    mpz_set(out, a);
+}
+
+void scalarNeg(Scalar &out, const Scalar &a, mpz_srcptr order) {
+    if (mpz_sgn(a.get()) == 0) {
+        mpz_set_ui(out, 0);
+    } else {
+        mpz_sub(out, order, a);
+    }
+}
+
+void scalarResponse(Scalar &out, const Scalar &r, const Scalar &c, const Scalar &x, mpz_srcptr order) {
+    // out, r/c/x ile ayni nesne olabilir; carpim once gecicide tutulur
+    mpz_t t;
+    mpz_init(t);
+    mpz_mul(t, c, x);
+    mpz_sub(t, r, t);
+    mpz_mod(out, t, order);
+    mpz_clear(t);
+}
+
+void scalarPow(element_t out, element_t base, const Scalar &e) {
+    element_pow_mpz(out, base, e);
+}
+
+void scalarPow2(element_t out, element_t b1, const Scalar &e1, element_t b2, const Scalar &e2) {
+    element_pow2_mpz(out, b1, e1, b2, e2);
+}
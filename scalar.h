@@ -0,0 +1,34 @@
+#ifndef SCALAR_H
+#define SCALAR_H
+
+#include "pbchandle.h"
+#include <cstddef>
+#include <string>
+
+// Zr skaleri (gizli anahtar payi, nonce, challenge, DID degeri) icin tek tur:
+// [0, r) araliginda tutulan mpz. PBC'nin element_pow_zn'i ustu her cagrida
+// gecici bir mpz'ye cevirdiginden ustel alma dogrudan element_pow_mpz /
+// element_pow2_mpz ile yapilir ve Schnorr yanitlari (s = r - c*x) GMP'de
+// hesaplanir. Zr Element'e yalnizca tel/depo formatindaki kanit alanlarina
+// yazarken gecilir. Tur pbchandle.h'deki Mpz'dir; islemler asagidaki
+// serbest fonksiyonlarla yapilir.
+using Scalar = Mpz;
+
+void scalarRandom(Scalar &out, mpz_srcptr order);
+// Onaltilik dize (DID) mod r; gecersiz dizede runtime_error
+void scalarFromHex(Scalar &out, const std::string &hex, mpz_srcptr order);
+// Big-endian ozet (SHA-512) mod r
+void scalarFromDigest(Scalar &out, const unsigned char *digest, size_t len, mpz_srcptr order);
+void scalarFromElement(Scalar &out, element_t zr);
+void scalarToElement(element_t zr, const Scalar &s);
+void scalarSet(Scalar &out, const Scalar &a);
+void scalarNeg(Scalar &out, const Scalar &a, mpz_srcptr order);
+// out = r - c * x mod order
+void scalarResponse(Scalar &out, const Scalar &r, const Scalar &c, const Scalar &x, mpz_srcptr order);
+
+// out = base^e
+void scalarPow(element_t out, element_t base, const Scalar &e);
+// out = b1^e1 * b2^e2 (PBC'nin eszamanli ustel almasi, tek kare zinciri)
+void scalarPow2(element_t out, element_t b1, const Scalar &e1, element_t b2, const Scalar &e2);
+
+#endif
@@ -0,0 +1,126 @@
+#include "scratch.h"
+#include <deque>
+#include <mutex>
+#include <vector>
+
+struct ScratchWorkspace {
+    pairing_s *pairing = nullptr;
+    bool owned = false;
+    // G1, G2, GT, Zr; deque buyurken verilmis adresler sabit kalir
+    std::deque<element_s> pool[4];
+    size_t top[4] = {0, 0, 0, 0};
+};
+
+namespace {
+
+// Alanlar sureclerin sonuna kadar yasar ve yikicida temizlenmez: cikista
+// pairing coktan serbest birakilmis olabilir. Biten is parcacigin alani
+// sahipsiz kalir ve ayni pairing'i kullanan yeni bir is parcacigina verilir.
+std::mutex registryMutex;
+std::vector<ScratchWorkspace*> &registry() {
+    static std::vector<ScratchWorkspace*> *all = new std::vector<ScratchWorkspace*>();
+    return *all;
+}
+
+struct ThreadSlots {
+    std::vector<ScratchWorkspace*> mine;
+    ~ThreadSlots() {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (ScratchWorkspace *ws : mine) {
+            ws->owned = false;
+        }
+    }
+};
+
+thread_local ThreadSlots slots;
+
+ScratchWorkspace *acquire(pairing_s *pairing) {
+    for (ScratchWorkspace *ws : slots.mine) {
+        if (ws->pairing == pairing) {
+            return ws;
+        }
+    }
+    // Bu is parcacigin bosaltilmis alani yeniden baglanir
+    for (ScratchWorkspace *ws : slots.mine) {
+        if (ws->pairing == nullptr) {
+            ws->pairing = pairing;
+            return ws;
+        }
+    }
+    std::lock_guard<std::mutex> lock(registryMutex);
+    ScratchWorkspace *found = nullptr;
+    for (ScratchWorkspace *ws : registry()) {
+        if (!ws->owned && (ws->pairing == pairing || ws->pairing == nullptr)) {
+            found = ws;
+            if (ws->pairing == pairing) {
+                break;
+            }
+        }
+    }
+    if (!found) {
+        found = new ScratchWorkspace;
+        registry().push_back(found);
+    }
+    found->pairing = pairing;
+    found->owned = true;
+    slots.mine.push_back(found);
+    return found;
+}
+
+void initGroup(element_s *e, pairing_s *pairing, int g) {
+    switch (g) {
+        case 0:
+            element_init_G1(e, pairing);
+            break;
+        case 1:
+            element_init_G2(e, pairing);
+            break;
+        case 2:
+            element_init_GT(e, pairing);
+            break;
+        default:
+            element_init_Zr(e, pairing);
+            break;
+    }
+}
+
+}
+
+ScratchFrame::ScratchFrame(pairing_t pairing) : ws_(acquire(pairing)) {
+    for (int g = 0; g < 4; g++) {
+        mark_[g] = ws_->top[g];
+    }
+}
+
+ScratchFrame::~ScratchFrame() {
+    for (int g = 0; g < 4; g++) {
+        ws_->top[g] = mark_[g];
+    }
+}
+
+element_s *ScratchFrame::take(Group group) {
+    int g = (int)group;
+    std::deque<element_s> &pool = ws_->pool[g];
+    if (ws_->top[g] == pool.size()) {
+        pool.emplace_back();
+        initGroup(&pool.back(), ws_->pairing, g);
+    }
+    return &pool[ws_->top[g]++];
+}
+
+void scratchDiscard(pairing_t pairing) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (ScratchWorkspace *ws : registry()) {
+        if (ws->pairing != pairing) {
+            continue;
+        }
+        for (int g = 0; g < 4; g++) {
+            for (element_s &e : ws->pool[g]) {
+                element_clear(&e);
+            }
+            ws->pool[g].clear();
+            ws->top[g] = 0;
+        }
+        ws->pairing = nullptr;
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef SCRATCH_H
+#define SCRATCH_H
+
+#include "pbchandle.h"
+#include <cstddef>
+
+// Is parcacigina ozel, onceden init edilmis gecici eleman alani. Sicak
+// fonksiyonlar gecicilerini her cagrida element_init/element_clear etmek
+// yerine bir ScratchFrame'den alir; cerceve kapaninca elemanlar
+// temizlenmeden havuza doner (yigin gibi, ic ice cerceveler serbest).
+// Havuz ilk cagrilarda buyur, sonrasinda cagri basina ayirma yapilmaz.
+// Verilen elemanin degeri onceki kullanimdan kalir; okumadan once yazilmali.
+struct ScratchWorkspace;
+
+class ScratchFrame {
+public:
+    explicit ScratchFrame(pairing_t pairing);
+    ~ScratchFrame();
+
+    ScratchFrame(const ScratchFrame &) = delete;
+    ScratchFrame &operator=(const ScratchFrame &) = delete;
+
+    element_s *take(Group group);
+    element_s *g1() { return take(Group::G1); }
+    element_s *g2() { return take(Group::G2); }
+    element_s *gt() { return take(Group::GT); }
+    element_s *zr() { return take(Group::Zr); }
+
+private:
+    ScratchWorkspace *ws_;
+    size_t mark_[4];
+};
+
+// Pairing'e bagli tum is parcacigi alanlarindaki elemanlari temizler.
+// clearParams pairing_clear'dan once cagirir; o anda acik cerceve olmamali.
+void scratchDiscard(pairing_t pairing);
+
+#endif
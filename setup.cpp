@@ -1,15 +1,62 @@
 #include "setup.h"
+#include "scratch.h"
 #include <iostream>
 #include <stdexcept>
 #include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+
+static std::string paramToText(pbc_param_t par) {
+    char *buf = nullptr;
+    size_t len = 0;
+    FILE *stream = open_memstream(&buf, &len);
+    if (!stream) {
+        throw std::runtime_error("paramToText: open_memstream failed");
+    }
+    pbc_param_out_str(stream, par);
+    fclose(stream);
+    std::string text(buf, len);
+    free(buf);
+    return text;
+}
+
+// pbc_param_out_str satirlari "anahtar deger" bicimindedir
+static void loadCurveConstants(TIACParams &params) {
+    std::istringstream in(params.paramText);
+    std::string line;
+    bool haveQ = false, haveH = false;
+    while (std::getline(in, line)) {
+        if (line.rfind("q ", 0) == 0) {
+            haveQ = mpz_set_str(params.field_order, line.c_str() + 2, 10) == 0;
+        } else if (line.rfind("h ", 0) == 0) {
+            haveH = mpz_set_str(params.cofactor, line.c_str() + 2, 10) == 0;
+        }
+    }
+    if (!haveQ || !haveH) {
+        throw std::runtime_error("loadCurveConstants: type A parameters need q and h");
+    }
+}
 
 TIACParams setupParams() {
+    return setupParams(256, 512);
+}
+
+TIACParams setupParams(int rbits, int qbits) {
+    if (rbits <= 0 || qbits <= rbits) {
+        throw std::runtime_error("setupParams: need 0 < rbits < qbits");
+    }
     TIACParams params;
     mpz_init(params.prime_order);
     pbc_param_t par;
-    pbc_param_init_a_gen(par, 256, 512);
+    pbc_param_init_a_gen(par, rbits, qbits);
     pairing_init_pbc_param(params.pairing, par);
+    params.paramText = paramToText(par);
+    OPCOUNT_REGISTER_PAIRING(params.pairing);
     mpz_set(params.prime_order, params.pairing->r);
+    mpz_init(params.field_order);
+    mpz_init(params.cofactor);
+    loadCurveConstants(params);
     element_init_G1(params.g1, params.pairing);
     element_init_G1(params.h1, params.pairing);
     element_init_G2(params.g2, params.pairing);
@@ -20,10 +67,34 @@ TIACParams setupParams() {
     return params;
 }
 
+TIACParams setupParamsFromText(const std::string &paramText) {
+    TIACParams params;
+    pbc_param_t par;
+    if (pbc_param_init_set_buf(par, paramText.data(), paramText.size()) != 0) {
+        throw std::runtime_error("setupParamsFromText: invalid pairing parameters");
+    }
+    mpz_init(params.prime_order);
+    pairing_init_pbc_param(params.pairing, par);
+    pbc_param_clear(par);
+    params.paramText = paramText;
+    OPCOUNT_REGISTER_PAIRING(params.pairing);
+    mpz_set(params.prime_order, params.pairing->r);
+    mpz_init(params.field_order);
+    mpz_init(params.cofactor);
+    loadCurveConstants(params);
+    element_init_G1(params.g1, params.pairing);
+    element_init_G1(params.h1, params.pairing);
+    element_init_G2(params.g2, params.pairing);
+    return params;
+}
+
 void clearParams(TIACParams &params) {
+    scratchDiscard(params.pairing);
     element_clear(params.g1);
     element_clear(params.h1);
     element_clear(params.g2);
     mpz_clear(params.prime_order);
+    mpz_clear(params.field_order);
+    mpz_clear(params.cofactor);
     pairing_clear(params.pairing);
 }
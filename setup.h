@@ -3,17 +3,41 @@
 
 #include <pbc/pbc.h>
 #include <gmp.h>
+#include "pbchandle.h"
+#include <string>
 
 struct TIACParams {
     pairing_t pairing; 
     mpz_t prime_order;
+    // Tip A taban alani q ve kofaktor h = (q + 1) / r; paramText'ten okunur,
+    // hashToG1 kullanir
+    mpz_t field_order;
+    mpz_t cofactor;
     element_t g1;
     element_t g2;
     element_t h1;
+    // pbc_param_out_str ciktisi; ayni pairing'i baska bir surecte kurmak icin
+    std::string paramText;
 };
 
 TIACParams setupParams();
 
+// Tip A egri: rbits bitlik grup mertebesi r, qbits bitlik taban alani q.
+// setupParams() == setupParams(256, 512).
+TIACParams setupParams(int rbits, int qbits);
+
+// Kayitli parametre metninden pairing kurar. g1, g2, h1 init edilir ama
+// degerleri cagiran tarafindan (ornegin credential store basligindan) yuklenir.
+TIACParams setupParamsFromText(const std::string &paramText);
+
 void clearParams(TIACParams &params);
 
+// Element'ler pairing'in alanlarina bagli oldugundan pairing en son
+// temizlenmeli: guard parametrelerden hemen sonra tanimlanir, boylece
+// sonra tanimlanan tum Element sahiplerinden sonra yok edilir.
+struct ParamsGuard {
+    TIACParams &params;
+    ~ParamsGuard() { clearParams(params); }
+};
+
 #endif
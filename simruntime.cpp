@@ -0,0 +1,28 @@
+#include "simruntime.h"
+
+void Simulator::at(SimTime time, std::function<void()> fn) {
+    if (time < now_) {
+        time = now_;
+    }
+    queue_.push(Event{time, seq_++, std::move(fn)});
+}
+
+void Simulator::spawn(SimTask task) {
+    auto h = task.handle;
+    after(0, [h] { h.resume(); });
+}
+
+void Simulator::run() {
+    while (!queue_.empty()) {
+        // priority_queue::top const doner; fn'i tasimak icin kopya alinir
+        Event ev = queue_.top();
+        queue_.pop();
+        now_ = ev.time;
+        ev.fn();
+        if (simPendingError) {
+            std::exception_ptr err = simPendingError;
+            simPendingError = nullptr;
+            std::rethrow_exception(err);
+        }
+    }
+}
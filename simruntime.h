@@ -0,0 +1,157 @@
+#ifndef SIMRUNTIME_H
+#define SIMRUNTIME_H
+
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+// Tek thread'li ayrik olay simulatoru. Zaman sanaldir (mikrosaniye); olaylar
+// zaman sirasina, esit zamanda ekleme sirasina gore calisir. Coroutine'ler
+// sleep/recv ile askiya alinir ve ilgili olay gelince devam eder.
+
+using SimTime = long long;
+
+inline thread_local std::exception_ptr simPendingError;
+
+// Atesle-unut coroutine: spawn edilene kadar baslamaz, bitince kendini yok eder.
+struct SimTask {
+    struct promise_type {
+        SimTask get_return_object() {
+            return SimTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { simPendingError = std::current_exception(); }
+    };
+    std::coroutine_handle<promise_type> handle;
+};
+
+class Simulator {
+public:
+    SimTime now() const { return now_; }
+
+    void at(SimTime time, std::function<void()> fn);
+    void after(SimTime delay, std::function<void()> fn) { at(now_ + delay, std::move(fn)); }
+    void spawn(SimTask task);
+
+    // Kuyruk bosalana kadar olaylari isler. Bir coroutine'den kacan
+    // istisna burada yeniden firlatilir.
+    void run();
+
+    struct SleepAwaiter {
+        Simulator &sim;
+        SimTime delay;
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> h) { sim.after(delay, [h] { h.resume(); }); }
+        void await_resume() const noexcept {}
+    };
+    SleepAwaiter sleep(SimTime delay) { return SleepAwaiter{*this, delay < 0 ? 0 : delay}; }
+
+private:
+    struct Event {
+        SimTime time;
+        uint64_t seq;
+        std::function<void()> fn;
+    };
+    struct Later {
+        bool operator()(const Event &a, const Event &b) const {
+            return a.time > b.time || (a.time == b.time && a.seq > b.seq);
+        }
+    };
+    std::priority_queue<Event, std::vector<Event>, Later> queue_;
+    SimTime now_ = 0;
+    uint64_t seq_ = 0;
+};
+
+// Tek alicili mesaj kutusu. recv(timeout) zaman asiminda ya da kutu
+// kapatildiginda bos optional doner.
+template <typename T>
+class Mailbox {
+public:
+    explicit Mailbox(Simulator &sim) : sim_(&sim) {}
+
+    Mailbox(const Mailbox &) = delete;
+    Mailbox &operator=(const Mailbox &) = delete;
+
+    void push(T msg) {
+        if (closed_) {
+            return;
+        }
+        if (waiter_) {
+            *slot_ = std::move(msg);
+            wake();
+            return;
+        }
+        queue_.push_back(std::move(msg));
+    }
+
+    void close() {
+        closed_ = true;
+        if (waiter_) {
+            wake();
+        }
+    }
+
+    bool closed() const { return closed_; }
+
+    std::optional<T> tryPop() {
+        if (queue_.empty()) {
+            return std::nullopt;
+        }
+        std::optional<T> msg(std::move(queue_.front()));
+        queue_.pop_front();
+        return msg;
+    }
+
+    struct RecvAwaiter {
+        Mailbox &box;
+        SimTime timeout;
+        std::optional<T> result;
+
+        bool await_ready() {
+            result = box.tryPop();
+            return result.has_value() || box.closed_;
+        }
+        void await_suspend(std::coroutine_handle<> h) {
+            box.waiter_ = h;
+            box.slot_ = &result;
+            uint64_t id = ++box.waitId_;
+            if (timeout >= 0) {
+                Mailbox *mb = &box;
+                box.sim_->after(timeout, [mb, id] {
+                    if (mb->waiter_ && mb->waitId_ == id) {
+                        mb->wake();
+                    }
+                });
+            }
+        }
+        std::optional<T> await_resume() { return std::move(result); }
+    };
+
+    // timeout < 0: suresiz bekler
+    RecvAwaiter recv(SimTime timeout = -1) { return RecvAwaiter{*this, timeout, std::nullopt}; }
+
+private:
+    void wake() {
+        std::coroutine_handle<> h = waiter_;
+        waiter_ = nullptr;
+        slot_ = nullptr;
+        sim_->after(0, [h] { h.resume(); });
+    }
+
+    Simulator *sim_;
+    std::deque<T> queue_;
+    std::coroutine_handle<> waiter_;
+    std::optional<T> *slot_ = nullptr;
+    uint64_t waitId_ = 0;
+    bool closed_ = false;
+};
+
+#endif
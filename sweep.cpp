@@ -0,0 +1,178 @@
+#include "sweep.h"
+#include "setup.h"
+#include "keygen.h"
+#include "didgen.h"
+#include "voterchain.h"
+#include "memstat.h"
+#include "rng.h"
+#include <tbb/global_control.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+using Clock = std::chrono::steady_clock;
+
+static long long elapsedUs(Clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+}
+
+std::vector<int> parseSweepList(const std::string &text) {
+    std::vector<int> out;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (item.empty()) {
+            continue;
+        }
+        size_t dash = item.find('-', 1);
+        if (dash == std::string::npos) {
+            out.push_back(std::stoi(item));
+            continue;
+        }
+        size_t stepAt = item.find_first_of("*+", dash);
+        int lo = std::stoi(item.substr(0, dash));
+        int hi = std::stoi(item.substr(dash + 1, stepAt == std::string::npos ? std::string::npos : stepAt - dash - 1));
+        char op = stepAt == std::string::npos ? '+' : item[stepAt];
+        int step = stepAt == std::string::npos ? 1 : std::stoi(item.substr(stepAt + 1));
+        if (lo > hi || (op == '+' && step <= 0) || (op == '*' && (step <= 1 || lo <= 0))) {
+            throw std::runtime_error("parseSweepList: bad range '" + item + "'");
+        }
+        for (long v = lo; v <= hi; v = op == '*' ? v * step : v + step) {
+            out.push_back((int)v);
+        }
+    }
+    if (out.empty()) {
+        throw std::runtime_error("parseSweepList: empty list '" + text + "'");
+    }
+    return out;
+}
+
+std::vector<std::pair<int, int>> parseCurveList(const std::string &text) {
+    std::vector<std::pair<int, int>> out;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (item.empty()) {
+            continue;
+        }
+        size_t colon = item.find(':');
+        if (colon == std::string::npos) {
+            throw std::runtime_error("parseCurveList: expected rbits:qbits, got '" + item + "'");
+        }
+        out.emplace_back(std::stoi(item.substr(0, colon)), std::stoi(item.substr(colon + 1)));
+    }
+    if (out.empty()) {
+        throw std::runtime_error("parseCurveList: empty list '" + text + "'");
+    }
+    return out;
+}
+
+int runSweep(const SweepConfig &config) {
+    std::ofstream csv(config.csvPath, std::ios::trunc);
+    if (!csv) {
+        throw std::runtime_error("runSweep: cannot write " + config.csvPath);
+    }
+    csv << "rbits,qbits,ea,threshold,voters,threads,setup_ms,keygen_ms,did_ms,"
+           "prep_ms,blind_ms,unblind_ms,aggregate_ms,prove_ms,kor_ms,verify_ms,"
+           "wall_ms,voters_per_s,latency_p50_ms,latency_p99_ms,latency_max_ms,verified,peak_rss_kb\n";
+
+    const int hwThreads = (int)std::thread::hardware_concurrency();
+    bool rssReset = resetPeakRss();
+    if (!rssReset) {
+        std::cerr << "Uyari: /proc/self/clear_refs yok, peak_rss_kb surec basindan itibaren olculur\n";
+    }
+    int rows = 0;
+
+    for (const auto &curve : config.curves) {
+        auto setupStart = Clock::now();
+        TIACParams params = setupParams(curve.first, curve.second);
+        ParamsGuard paramsGuard{params};
+        long long setup_us = elapsedUs(setupStart);
+
+        // Gecerli her (ea, esik) icin anahtarlar bu egride bir kez uretilir
+        struct KeySet {
+            int ne;
+            int t;
+            KeyGenOutput keys;
+            long long keygen_us;
+        };
+        std::vector<KeySet> keySets;
+        for (int ne : config.eas) {
+            for (int t : config.thresholds) {
+                if (t <= 0 || t > ne) {
+                    continue;
+                }
+                auto keygenStart = Clock::now();
+                KeyGenOutput keys = keygen(params, t, ne);
+                keySets.push_back(KeySet{ne, t, std::move(keys), elapsedUs(keygenStart)});
+            }
+        }
+
+        for (int voterCount : config.voters) {
+            auto didStart = Clock::now();
+            std::vector<DID> dids;
+            {
+                std::mt19937_64 gen(randomU64());
+                std::uniform_int_distribution<unsigned long long> dist(10000000000ULL, 99999999999ULL);
+                std::vector<std::string> userIds(voterCount);
+                for (int i = 0; i < voterCount; i++) {
+                    userIds[i] = std::to_string(dist(gen));
+                }
+                dids = createDIDs(params, userIds);
+            }
+            long long did_us = elapsedUs(didStart);
+
+            for (KeySet &ks : keySets) {
+                std::vector<std::vector<int>> adminSets(voterCount);
+                std::mt19937 rng(randomU64());
+                std::vector<int> adminIndices(ks.ne);
+                for (int i = 0; i < voterCount; i++) {
+                    std::iota(adminIndices.begin(), adminIndices.end(), 0);
+                    std::shuffle(adminIndices.begin(), adminIndices.end(), rng);
+                    adminSets[i].assign(adminIndices.begin(), adminIndices.begin() + ks.t);
+                }
+
+                for (int threads : config.threads) {
+                    int n = threads <= 0 ? hwThreads : threads;
+                    tbb::global_control gc(tbb::global_control::max_allowed_parallelism, (size_t)n);
+                    // TBB etkin sinirlarin en kucugunu uygular (main'deki
+                    // hardware_concurrency siniri dahil); CSV'ye etkin deger yazilir
+                    int effective = (int)tbb::global_control::active_value(tbb::global_control::max_allowed_parallelism);
+                    if (effective != n) {
+                        std::cout << "sweep: " << n << " is parcacigi istendi, TBB " << effective << " ile sinirliyor\n";
+                    }
+                    if (rssReset) {
+                        resetPeakRss();
+                    }
+                    ChainReport rep = runVoterChains(params, ks.keys, dids, adminSets);
+                    long peakKb = peakRssKb();
+                    double wall_ms = rep.wall_us / 1000.0;
+                    csv << curve.first << ',' << curve.second << ',' << ks.ne << ',' << ks.t << ','
+                        << voterCount << ',' << effective << ','
+                        << setup_us / 1000.0 << ',' << ks.keygen_us / 1000.0 << ',' << did_us / 1000.0 << ','
+                        << rep.times.prep_us / 1000.0 << ',' << rep.times.blind_us / 1000.0 << ','
+                        << rep.times.unblind_us / 1000.0 << ',' << rep.times.aggregate_us / 1000.0 << ','
+                        << rep.times.prove_us / 1000.0 << ',' << rep.times.kor_us / 1000.0 << ','
+                        << rep.times.verify_us / 1000.0 << ',' << wall_ms << ','
+                        << (wall_ms > 0 ? voterCount * 1000.0 / wall_ms : 0.0) << ','
+                        << rep.latencyP50_us / 1000.0 << ',' << rep.latencyP99_us / 1000.0 << ','
+                        << rep.latencyMax_us / 1000.0 << ',' << rep.verified << ',' << peakKb << '\n';
+                    csv.flush();
+                    rows++;
+                    std::cout << "[" << rows << "] r" << curve.first << "/q" << curve.second
+                              << " ea=" << ks.ne << " t=" << ks.t << " n=" << voterCount << " thr=" << effective
+                              << " : " << wall_ms << " ms, " << rep.verified << "/" << voterCount << " dogrulandi\n";
+                    if (rep.verified != (size_t)voterCount) {
+                        throw std::runtime_error("runSweep: " + std::to_string(voterCount - (int)rep.verified) + " show(s) rejected");
+                    }
+                }
+            }
+        }
+    }
+    return rows;
+}
@@ -0,0 +1,32 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+// Parametre taramasi: her (egri, ea, esik, secmen, is parcacigi) kombinasyonu
+// icin zincir modunda (runVoterChains) tam ihrac + dogrulama calistirilir ve
+// CSV'ye bir satir yazilir. Setup egri basina, keygen (egri, ea, esik)
+// basina, DID'ler (egri, secmen) basina bir kez yapilir; esik > ea olan
+// kombinasyonlar atlanir. threads sutunu TBB'nin etkin paralellik sinirini
+// yazar; cekirdek sayisini asan istekler bununla sinirlanir.
+struct SweepConfig {
+    std::vector<std::pair<int, int>> curves;   // (rbits, qbits)
+    std::vector<int> eas;
+    std::vector<int> thresholds;
+    std::vector<int> voters;
+    std::vector<int> threads;
+    std::string csvPath = "sweep.csv";
+};
+
+// "3,5,7", "1-8" ya da "1-64*2" (carpimsal adim) / "100-1000+300" (toplamsal adim)
+std::vector<int> parseSweepList(const std::string &text);
+
+// "256:512,160:512"
+std::vector<std::pair<int, int>> parseCurveList(const std::string &text);
+
+// Yazilan satir sayisini dondurur.
+int runSweep(const SweepConfig &config);
+
+#endif
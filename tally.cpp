@@ -0,0 +1,190 @@
+#include "tally.h"
+#include "aggregate.h"
+#include "voterbatch.h"
+#include "scratch.h"
+#include <tbb/parallel_reduce.h>
+#include <tbb/blocked_range.h>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+static uint64_t elementKey(element_t e) {
+    int len = element_length_in_bytes(e);
+    std::vector<unsigned char> buf(len);
+    element_to_bytes(buf.data(), e);
+    // x ve y birlikte katlanir; P ve P^-1 ayni x'e sahiptir
+    uint64_t key = 0x9e3779b97f4a7c15ULL;
+    for (int i = 0; i + 8 <= len; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, buf.data() + i, sizeof(word));
+        key = (key ^ word) * 0x100000001b3ULL;
+    }
+    return key;
+}
+
+Ballot encryptBallot(TIACParams &params, element_t electionKey, int vote) {
+    Ballot ballot;
+    ScratchFrame scratch(params.pairing);
+    element_s *r = scratch.zr();
+    element_s *v = scratch.zr();
+    element_s *h1_v = scratch.g1();
+    element_s *pk_r = scratch.g1();
+    element_random(r);
+    element_set_si(v, vote);
+    ballot.c1.init(params.pairing, Group::G1);
+    ballot.c2.init(params.pairing, Group::G1);
+    element_pow_zn(ballot.c1, params.g1, r);
+    element_pow_zn(h1_v, params.h1, v);
+    element_pow_zn(pk_r, electionKey, r);
+    element_mul(ballot.c2, h1_v, pk_r);
+    return ballot;
+}
+
+void initTally(TIACParams &params, TallyAccumulator &acc) {
+    acc.c1.init(params.pairing, Group::G1);
+    acc.c2.init(params.pairing, Group::G1);
+    element_set1(acc.c1);
+    element_set1(acc.c2);
+    acc.count = 0;
+}
+
+// tbb::parallel_reduce govdesi: her alt aralik kendi (c1, c2) carpimini tutar
+// ve oy sutunlarini sirayla okur
+struct BallotProduct {
+    TIACParams &params;
+    const VoterBatch &batch;
+    const std::vector<char> &verified;
+    long long count;
+    Element c1;
+    Element c2;
+    Element in1;
+    Element in2;
+
+    BallotProduct(TIACParams &p, const VoterBatch &b, const std::vector<char> &v)
+        : params(p), batch(b), verified(v), count(0), c1(p.pairing, Group::G1), c2(p.pairing, Group::G1),
+          in1(p.pairing, Group::G1), in2(p.pairing, Group::G1) {
+        element_set1(c1);
+        element_set1(c2);
+    }
+    BallotProduct(BallotProduct &other, tbb::split)
+        : params(other.params), batch(other.batch), verified(other.verified), count(0),
+          c1(other.params.pairing, Group::G1), c2(other.params.pairing, Group::G1),
+          in1(other.params.pairing, Group::G1), in2(other.params.pairing, Group::G1) {
+        element_set1(c1);
+        element_set1(c2);
+    }
+    void operator()(const tbb::blocked_range<size_t> &r) {
+        for (size_t i = r.begin(); i != r.end(); ++i) {
+            if (!verified[i]) {
+                continue;
+            }
+            count++;
+            loadElement(in1, batch.ballot_c1, i);
+            loadElement(in2, batch.ballot_c2, i);
+            element_mul(c1, c1, in1);
+            element_mul(c2, c2, in2);
+        }
+    }
+    void join(BallotProduct &rhs) {
+        count += rhs.count;
+        element_mul(c1, c1, rhs.c1);
+        element_mul(c2, c2, rhs.c2);
+    }
+};
+
+// Oylar parca parca gelebilir; her cagri parcayi paralel indirger ve
+// toplam sifreli metne katlar.
+void accumulateBallots(TIACParams &params, TallyAccumulator &acc, const VoterBatch &batch, const std::vector<char> &verified) {
+    if (verified.size() != batch.count) {
+        throw std::runtime_error("accumulateBallots: verified mask size mismatch");
+    }
+    if (batch.count == 0) {
+        return;
+    }
+    BallotProduct body(params, batch, verified);
+    tbb::parallel_reduce(tbb::blocked_range<size_t>(0, batch.count, 1024), body);
+    element_mul(acc.c1, acc.c1, body.c1);
+    element_mul(acc.c2, acc.c2, body.c2);
+    acc.count += body.count;
+}
+
+PartialDecryption partialDecrypt(TIACParams &params, TallyAccumulator &acc, EAKey &eaKey, int adminId) {
+    PartialDecryption pd;
+    pd.adminId = adminId;
+    pd.d.init(params.pairing, Group::G1);
+    scalarPow(pd.d, acc.c1, eaKey.sgk2);
+    return pd;
+}
+
+DlogTable buildDlogTable(TIACParams &params, long long maxValue) {
+    DlogTable table;
+    table.maxValue = maxValue;
+    table.m = (long long)std::ceil(std::sqrt((double)(maxValue + 1)));
+    if (table.m < 1) table.m = 1;
+    table.babySteps.reserve((size_t)table.m);
+    element_t cur;
+    element_init_G1(cur, params.pairing);
+    element_set1(cur);
+    for (long long j = 0; j < table.m; j++) {
+        table.babySteps.emplace(elementKey(cur), j);
+        element_mul(cur, cur, params.h1);
+    }
+    // cur = h1^m
+    table.giantStep.init(params.pairing, Group::G1);
+    element_invert(table.giantStep, cur);
+    element_clear(cur);
+    return table;
+}
+
+long long decryptTally(TIACParams &params, TallyAccumulator &acc, std::vector<PartialDecryption> &partials, DlogTable &table) {
+    if (partials.empty()) {
+        throw std::runtime_error("decryptTally: no partial decryptions");
+    }
+    std::vector<int> allIDs;
+    for (size_t i = 0; i < partials.size(); i++) {
+        allIDs.push_back(partials[i].adminId);
+    }
+    // c1^y = prod d_m^lambda_m
+    element_t c1_y, term;
+    Scalar lambda;
+    element_init_G1(c1_y, params.pairing);
+    element_init_G1(term, params.pairing);
+    element_set1(c1_y);
+    for (size_t i = 0; i < partials.size(); i++) {
+        computeLagrangeCoefficient(lambda, allIDs, i, params.prime_order);
+        scalarPow(term, partials[i].d, lambda);
+        element_mul(c1_y, c1_y, term);
+    }
+    // h1^tally = c2 / c1^y
+    element_t gamma;
+    element_init_G1(gamma, params.pairing);
+    element_div(gamma, acc.c2, c1_y);
+
+    long long result = -1;
+    for (long long i = 0; i <= table.m && result < 0; i++) {
+        auto it = table.babySteps.find(elementKey(gamma));
+        if (it != table.babySteps.end()) {
+            long long candidate = i * table.m + it->second;
+            // 64-bit anahtar carpismasina karsi adayi dogrula
+            element_t check, exp;
+            element_init_G1(check, params.pairing);
+            element_init_Zr(exp, params.pairing);
+            element_set_si(exp, (signed long)candidate);
+            element_pow_zn(check, params.h1, exp);
+            element_mul(check, check, c1_y);
+            if (element_cmp(check, acc.c2) == 0) {
+                result = candidate;
+            }
+            element_clear(check);
+            element_clear(exp);
+        }
+        element_mul(gamma, gamma, table.giantStep);
+    }
+    element_clear(c1_y);
+    element_clear(term);
+    element_clear(gamma);
+    if (result < 0 || result > table.maxValue) {
+        throw std::runtime_error("decryptTally: tally outside discrete log table range");
+    }
+    return result;
+}
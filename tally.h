@@ -0,0 +1,67 @@
+#ifndef TALLY_H
+#define TALLY_H
+
+#include "setup.h"
+#include "keygen.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+struct VoterBatch;
+
+// Ustel ElGamal oy: c1 = g1^r, c2 = h1^v * beta1^r
+// Secim acik anahtari mvk.beta1 = g1^y, EA paylari sgk2 = y_m.
+struct Ballot {
+    Element c1;
+    Element c2;
+};
+
+struct TallyAccumulator {
+    Element c1;
+    Element c2;
+    long long count;
+};
+
+struct PartialDecryption {
+    int adminId;
+    Element d;
+};
+
+// h1^j -> j (0 <= j < m) baby-step tablosu ve h1^-m giant-step carpani
+struct DlogTable {
+    long long maxValue;
+    long long m;
+    std::unordered_map<uint64_t, long long> babySteps;
+    Element giantStep;
+};
+
+Ballot encryptBallot(TIACParams &params, element_t electionKey, int vote);
+
+void initTally(TIACParams &params, TallyAccumulator &acc);
+
+// Yalnizca verified[i] != 0 satirlar katilir; reddedilen gosterimlerin oy
+// sutunlari bos (0 bayt) ya da onceki parcadan kalma olabilir
+void accumulateBallots(
+    TIACParams &params,
+    TallyAccumulator &acc,
+    const VoterBatch &batch,
+    const std::vector<char> &verified
+);
+
+PartialDecryption partialDecrypt(
+    TIACParams &params,
+    TallyAccumulator &acc,
+    EAKey &eaKey,
+    int adminId
+);
+
+DlogTable buildDlogTable(TIACParams &params, long long maxValue);
+
+long long decryptTally(
+    TIACParams &params,
+    TallyAccumulator &acc,
+    std::vector<PartialDecryption> &partials,
+    DlogTable &table
+);
+
+#endif
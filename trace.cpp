@@ -0,0 +1,130 @@
+#include "trace.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct TraceEvent {
+    const char *name;
+    long long voter;
+    int64_t start_ns;
+    int64_t dur_ns;
+};
+
+struct ThreadTrace {
+    int tid;
+    std::vector<TraceEvent> ring;
+    uint64_t head = 0;  // yazilan toplam olay; ring[head % size]
+};
+
+std::atomic<bool> enabled(false);
+Clock::time_point epoch;
+size_t capacity = 65536;
+std::string outPath;
+
+// Tamponlar cikisa kadar yasar: is parcacigi bitse de olaylari yazilir
+std::mutex registryMutex;
+std::vector<std::unique_ptr<ThreadTrace>> &registry() {
+    static std::vector<std::unique_ptr<ThreadTrace>> threads;
+    return threads;
+}
+
+thread_local ThreadTrace *localTrace = nullptr;
+
+ThreadTrace &threadTrace() {
+    if (!localTrace) {
+        std::unique_ptr<ThreadTrace> t(new ThreadTrace);
+        t->ring.resize(capacity);
+        std::lock_guard<std::mutex> lock(registryMutex);
+        t->tid = (int)registry().size() + 1;
+        localTrace = t.get();
+        registry().push_back(std::move(t));
+    }
+    return *localTrace;
+}
+
+int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - epoch).count();
+}
+
+void writeAtExit() {
+    traceWrite();
+}
+
+}
+
+void traceEnable(const std::string &path, size_t perThreadCapacity) {
+    if (enabled.load()) {
+        return;
+    }
+    outPath = path;
+    capacity = perThreadCapacity > 0 ? perThreadCapacity : 1;
+    epoch = Clock::now();
+    // registry() atexit kaydindan once olusur, yani ondan sonra yikilir
+    registry();
+    std::atexit(writeAtExit);
+    enabled.store(true, std::memory_order_release);
+}
+
+bool traceEnabled() {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+void traceWrite() {
+    if (!enabled.load() || outPath.empty()) {
+        return;
+    }
+    std::ofstream out(outPath);
+    if (!out) {
+        std::cerr << "Error: " << outPath << " yazilamadi!\n";
+        return;
+    }
+    std::lock_guard<std::mutex> lock(registryMutex);
+    uint64_t dropped = 0;
+    bool first = true;
+    char buf[96];
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    for (const auto &t : registry()) {
+        if (!first) out << ",\n";
+        first = false;
+        out << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << t->tid
+            << ", \"args\": {\"name\": \"thread " << t->tid << "\"}}";
+        size_t n = t->ring.size();
+        uint64_t count = t->head < n ? t->head : n;
+        dropped += t->head - count;
+        for (uint64_t k = t->head - count; k < t->head; k++) {
+            const TraceEvent &e = t->ring[k % n];
+            // ts/dur mikrosaniye; ns hassasiyeti ondalikta korunur
+            std::snprintf(buf, sizeof(buf), "\"ts\": %.3f, \"dur\": %.3f", e.start_ns / 1000.0, e.dur_ns / 1000.0);
+            out << ",\n{\"name\": \"" << e.name << "\", \"cat\": \"evoting\", \"ph\": \"X\", " << buf
+                << ", \"pid\": 1, \"tid\": " << t->tid;
+            if (e.voter >= 0) {
+                out << ", \"args\": {\"voter\": " << e.voter << "}";
+            }
+            out << "}";
+        }
+    }
+    out << "\n], \"otherData\": {\"dropped_events\": " << dropped << ", \"ring_capacity\": " << capacity << "}}\n";
+}
+
+TraceSpan::TraceSpan(const char *name, long long voter)
+    : name_(name), voter_(voter), start_(enabled.load(std::memory_order_relaxed) ? nowNs() : -1) {}
+
+TraceSpan::~TraceSpan() {
+    if (start_ < 0) {
+        return;
+    }
+    int64_t end = nowNs();
+    ThreadTrace &t = threadTrace();
+    t.ring[t.head % t.ring.size()] = TraceEvent{name_, voter_, start_, end - start_};
+    t.head++;
+}
@@ -0,0 +1,41 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Chrome/Perfetto trace-event zaman cizelgesi. traceEnable(path) ile acilir;
+// her is parcacigi kendi halka tamponuna kilitsiz yazar (dolunca en eski olay
+// ezilir). Program cikisinda (atexit) tum tamponlar path'e trace-event JSON
+// olarak yazilir: chrome://tracing ya da ui.perfetto.dev ile acilir.
+// Kapaliyken TRACE_SPAN bir atomic okuma kadar maliyetlidir.
+//
+// Tamponlar yazim sirasinda okunmaz; traceWrite() paralel bolge disinda
+// cagrilmali (atexit'te isciler zaten bostadir).
+
+void traceEnable(const std::string &path, size_t perThreadCapacity = 65536);
+bool traceEnabled();
+// Aninda yazar; atexit yazimi yine de yapilir (ayni dosyanin uzerine)
+void traceWrite();
+
+class TraceSpan {
+public:
+    // name statik omurlu olmali (string literal); voter < 0 ise args bos
+    explicit TraceSpan(const char *name, long long voter = -1);
+    ~TraceSpan();
+
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+private:
+    const char *name_;
+    long long voter_;
+    int64_t start_;
+};
+
+#define TRACE_CONCAT2(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT2(a, b)
+#define TRACE_SPAN(name, voter) TraceSpan TRACE_CONCAT(traceSpan_, __LINE__)(name, voter)
+
+#endif
@@ -0,0 +1,106 @@
+#include "udsconn.h"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static sockaddr_un unixAddress(const std::string &path) {
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        throw std::runtime_error("unix socket path too long: " + path);
+    }
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    return addr;
+}
+
+void setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+        throw std::runtime_error(std::string("setNonBlocking: ") + std::strerror(errno));
+    }
+}
+
+int listenUnix(const std::string &path, int backlog) {
+    sockaddr_un addr = unixAddress(path);
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw std::runtime_error(std::string("listenUnix: socket: ") + std::strerror(errno));
+    }
+    unlink(path.c_str());
+    if (bind(fd, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(fd, backlog) < 0) {
+        int err = errno;
+        close(fd);
+        throw std::runtime_error("listenUnix: " + path + ": " + std::strerror(err));
+    }
+    setNonBlocking(fd);
+    return fd;
+}
+
+int connectUnix(const std::string &path) {
+    sockaddr_un addr = unixAddress(path);
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw std::runtime_error(std::string("connectUnix: socket: ") + std::strerror(errno));
+    }
+    if (connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0) {
+        int err = errno;
+        close(fd);
+        throw std::runtime_error("connectUnix: " + path + ": " + std::strerror(err));
+    }
+    setNonBlocking(fd);
+    return fd;
+}
+
+bool readAvailable(UdsConnection &conn) {
+    unsigned char buf[65536];
+    while (true) {
+        ssize_t n = ::read(conn.fd, buf, sizeof(buf));
+        if (n > 0) {
+            conn.in.insert(conn.in.end(), buf, buf + n);
+            continue;
+        }
+        if (n == 0) {
+            return false;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return true;
+        }
+        return false;
+    }
+}
+
+bool flushPending(UdsConnection &conn) {
+    while (conn.outPos < conn.out.size()) {
+        ssize_t n = ::send(conn.fd, conn.out.data() + conn.outPos, conn.out.size() - conn.outPos, MSG_NOSIGNAL);
+        if (n > 0) {
+            conn.outPos += (size_t)n;
+            continue;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return false;
+        }
+        throw std::runtime_error(std::string("flushPending: send: ") + std::strerror(errno));
+    }
+    conn.out.clear();
+    conn.outPos = 0;
+    return true;
+}
+
+void compactInput(UdsConnection &conn) {
+    if (conn.inPos == 0) {
+        return;
+    }
+    conn.in.erase(conn.in.begin(), conn.in.begin() + conn.inPos);
+    conn.inPos = 0;
+}
@@ -0,0 +1,31 @@
+#ifndef UDSCONN_H
+#define UDSCONN_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Bloklamayan Unix-domain soket baglantisi ve okuma/yazma tamponlari.
+struct UdsConnection {
+    int fd = -1;
+    std::vector<unsigned char> in;
+    size_t inPos = 0;
+    std::vector<unsigned char> out;
+    size_t outPos = 0;
+    bool wantWrite = false;
+};
+
+int listenUnix(const std::string &path, int backlog);
+int connectUnix(const std::string &path);
+void setNonBlocking(int fd);
+
+// Okunabilen her seyi in'e ekler. Karsi taraf kapattiysa false doner.
+bool readAvailable(UdsConnection &conn);
+
+// out'taki bekleyen byte'lari yazar; hepsi gittiyse true doner.
+bool flushPending(UdsConnection &conn);
+
+// in'in tuketilmis on kismini atar (kalan kismi basa tasir).
+void compactInput(UdsConnection &conn);
+
+#endif
@@ -1,4 +1,6 @@
 #include "unblindsign.h"
+#include "pairinginverify.h"
+#include "scratch.h"
 #include <openssl/sha.h>
 #include <vector>
 #include <sstream>
@@ -24,18 +26,6 @@ std::string elementToStringG1(element_t elem) {
     return oss.str();
 }
 
-static void didStringToMpz(const std::string &didStr, mpz_t rop, const mpz_t p) {
-    if(mpz_set_str(rop, didStr.c_str(), 16) != 0)
-        throw std::runtime_error("didStringToMpz: invalid hex string");
-    mpz_mod(rop, rop, p);
-}
-
-static void hashToG1(element_t outG1, TIACParams &params, element_t inElem) {
-    std::string s = elementToStringG1(inElem);
-    element_from_hash(outG1, s.data(), s.size());
-    std::string outStr = elementToStringG1(outG1);
-}
-
 static void hashToZr(element_t outZr, TIACParams &params, const std::vector<std::string> &elems) {
     std::ostringstream oss;
     for (const auto &s : elems)
@@ -59,70 +49,34 @@ static void hashToZr(element_t outZr, TIACParams &params, const std::vector<std:
     mpz_clear(tmp);
 }
 
-UnblindSignature unblindSign(TIACParams &params,PrepareBlindSignOutput &bsOut,BlindSignature &blindSig,EAKey &eaKey,const std::string &didStr) {
+UnblindSignature unblindSign(TIACParams &params,PrepareBlindSignOutput &bsOut,BlindSignature &blindSig,EAKey &eaKey) {
     UnblindSignature result;
-    element_init_G1(result.h, params.pairing);
+    result.h.init(params.pairing, Group::G1);
     element_set(result.h, blindSig.h);    
-    element_t h_check;
-    element_init_G1(h_check, params.pairing);
-    hashToG1(h_check, params, bsOut.comi);
-    result.debug.hash_comi = elementToStringG1(h_check);
-    if(element_cmp(h_check, bsOut.h) != 0) {
-        element_clear(h_check);
-        throw std::runtime_error("unblindSign: Hash(comi) != h");
+    // h = Hash(comi) secmenin kendi prepare ciktisinda bir kez hesaplandi;
+    // burada yalnizca EA'nin ayni h'yi imzaladigi kontrol edilir
+    if(element_cmp(blindSig.h, bsOut.h) != 0) {
+        throw std::runtime_error("unblindSign: signature h != Hash(comi)");
     }
-    element_clear(h_check);
-    mpz_t neg_o;
-    mpz_init(neg_o);
-    mpz_neg(neg_o, bsOut.o);
-    mpz_mod(neg_o, neg_o, params.prime_order);
-    element_t exponent;
-    element_init_Zr(exponent, params.pairing);
-    element_set_mpz(exponent, neg_o);
-    mpz_clear(neg_o);
-    element_t beta_pow;
-    element_init_G1(beta_pow, params.pairing);
-    element_pow_zn(beta_pow, eaKey.vkm3, exponent);
-    element_clear(exponent);
-    element_init_G1(result.s_m, params.pairing);
+    result.debug.hash_comi = bsOut.h_str;
+    ScratchFrame scratch(params.pairing);
+    Scalar neg_o;
+    scalarNeg(neg_o, bsOut.o, params.prime_order);
+    element_s *beta_pow = scratch.g1();
+    scalarPow(beta_pow, eaKey.vkm3, neg_o);
+    result.s_m.init(params.pairing, Group::G1);
     element_mul(result.s_m, blindSig.cm, beta_pow);
     result.debug.computed_s_m = elementToStringG1(result.s_m);
-    element_clear(beta_pow);
-    mpz_t didInt;
-    mpz_init(didInt);
-    didStringToMpz(didStr, didInt, params.prime_order);
-    element_init_Zr(exponent, params.pairing);
-    element_set_mpz(exponent, didInt);
-    mpz_clear(didInt);
-    element_t beta_did;
-    element_init_G1(beta_did, params.pairing);
-    element_pow_zn(beta_did, eaKey.vkm2, exponent);
-    element_clear(exponent);
-    element_t multiplier;
-    element_init_G1(multiplier, params.pairing);
+    element_s *beta_did = scratch.g1();
+    scalarPow(beta_did, eaKey.vkm2, bsOut.did);
+    element_s *multiplier = scratch.g1();
     element_mul(multiplier, eaKey.vkm1, beta_did);
-    element_clear(beta_did);
-    element_t pairing_lhs, pairing_rhs;
-    element_init_GT(pairing_lhs, params.pairing);
-    element_init_GT(pairing_rhs, params.pairing);
-    pairing_apply(pairing_lhs, result.h, multiplier, params.pairing);
-    element_clear(multiplier);
-    pairing_apply(pairing_rhs, result.s_m, params.g2, params.pairing);    
-    auto gtToString = [&params](element_t gt_elem) -> std::string {
-        int len = element_length_in_bytes(gt_elem);
-        std::vector<unsigned char> buf(len);
-        element_to_bytes(buf.data(), gt_elem);
-        std::ostringstream oss;
-        oss << std::hex << std::setfill('0');
-        for (auto c : buf)
-            oss << std::setw(2) << (int)c;
-        return oss.str();
-    };
-    result.debug.pairing_lhs = gtToString(pairing_lhs);
-    result.debug.pairing_rhs = gtToString(pairing_rhs);
-    bool pairing_ok = (element_cmp(pairing_lhs, pairing_rhs) == 0);
-    element_clear(pairing_lhs);
-    element_clear(pairing_rhs);
+    element_s *s_m_inv = scratch.g1();
+    element_invert(s_m_inv, result.s_m);
+    bool pairing_ok = pairingProductIsOne(params, {
+        {result.h, multiplier},
+        {s_m_inv, params.g2}
+    });
     if(!pairing_ok) {
         throw std::runtime_error("unblindSign: Pairing check failed");
     }    
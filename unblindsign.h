@@ -10,13 +10,11 @@
 std::string elementToStringG1(element_t elem);
 
 struct UnblindSignature {
-    element_t h;   
-    element_t s_m; 
+    Element h;   
+    Element s_m; 
     struct {
         std::string hash_comi;    
         std::string computed_s_m; 
-        std::string pairing_lhs; 
-        std::string pairing_rhs;
     } debug;
 };
 
@@ -25,8 +23,7 @@ UnblindSignature unblindSign(
     TIACParams &params,
     PrepareBlindSignOutput &bsOut,
     BlindSignature &blindSig,
-    EAKey &eaKey,
-    const std::string &didStr
+    EAKey &eaKey
 );
 
 #endif
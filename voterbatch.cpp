@@ -0,0 +1,124 @@
+#include "voterbatch.h"
+#include "pairinginverify.h"
+#include "checkkorverify.h"
+#include "hashmany.h"
+#include <openssl/sha.h>
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <atomic>
+#include <stdexcept>
+
+// hashMany seritlerini doldurmaya yetecek aralik boyu
+static const size_t kVerifyGrain = 32;
+
+static void initColumn(ElementColumn &col, size_t width, size_t count) {
+    col.width = width;
+    col.data.assign(width * count, 0);
+}
+
+void initVoterBatch(TIACParams &params, VoterBatch &batch, size_t count) {
+    size_t g1 = (size_t)pairing_length_in_bytes_G1(params.pairing);
+    size_t g2 = (size_t)pairing_length_in_bytes_G2(params.pairing);
+    size_t zr = (size_t)pairing_length_in_bytes_Zr(params.pairing);
+    batch.count = count;
+    initColumn(batch.com, g1, count);
+    initColumn(batch.agg_h, g1, count);
+    initColumn(batch.show_h, g1, count);
+    initColumn(batch.show_s, g1, count);
+    initColumn(batch.show_k, g2, count);
+    initColumn(batch.show_c, zr, count);
+    initColumn(batch.show_s1, zr, count);
+    initColumn(batch.show_s2, zr, count);
+    initColumn(batch.show_s3, zr, count);
+    initColumn(batch.ballot_c1, g1, count);
+    initColumn(batch.ballot_c2, g1, count);
+}
+
+void storeElement(ElementColumn &col, size_t i, element_t e) {
+    if ((size_t)element_length_in_bytes(e) != col.width) {
+        throw std::runtime_error("storeElement: element width does not match column");
+    }
+    element_to_bytes(col.slot(i), e);
+}
+
+void loadElement(element_t e, const ElementColumn &col, size_t i) {
+    element_from_bytes(e, const_cast<unsigned char*>(col.slot(i)));
+}
+
+void storeCredential(VoterBatch &batch, size_t i, PrepareBlindSignOutput &prep, AggregateSignature &agg, ProveCredentialOutput &proof) {
+    storeElement(batch.com, i, prep.com);
+    storeElement(batch.agg_h, i, agg.h);
+    storeElement(batch.show_h, i, proof.sigmaRnd.h);
+    storeElement(batch.show_s, i, proof.sigmaRnd.s);
+    storeElement(batch.show_k, i, proof.k);
+    storeElement(batch.show_c, i, proof.c);
+    storeElement(batch.show_s1, i, proof.s1);
+    storeElement(batch.show_s2, i, proof.s2);
+    storeElement(batch.show_s3, i, proof.s3);
+}
+
+void storeBallot(VoterBatch &batch, size_t i, Ballot &ballot) {
+    storeElement(batch.ballot_c1, i, ballot.c1);
+    storeElement(batch.ballot_c2, i, ballot.c2);
+}
+
+size_t verifyShowBatch(TIACParams &params, const MasterVerKey &mvk, const VoterBatch &batch, DoubleShowIndex &index, std::vector<char> &ok) {
+    ok.assign(batch.count, 0);
+    std::atomic<size_t> valid(0);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, batch.count, kVerifyGrain),
+        [&](const tbb::blocked_range<size_t> &r) {
+            // Aralik basina bir kez ayrilan calisma elemanlari
+            Element com(params.pairing, Group::G1), aggH(params.pairing, Group::G1);
+            Element h(params.pairing, Group::G1), s(params.pairing, Group::G1);
+            Element k(params.pairing, Group::G2);
+            Element c(params.pairing, Group::Zr), s1(params.pairing, Group::Zr);
+            Element s2(params.pairing, Group::Zr), s3(params.pairing, Group::Zr);
+            // KoR meydan okuma ozetleri aralik sonunda tek hashMany ile alinir
+            std::vector<size_t> pending;
+            std::vector<ShowTag> tags;
+            std::vector<std::string> transcripts;
+            pending.reserve(r.size());
+            tags.reserve(r.size());
+            transcripts.reserve(r.size());
+            for (size_t i = r.begin(); i != r.end(); ++i) {
+                loadElement(com, batch.com, i);
+                loadElement(aggH, batch.agg_h, i);
+                // com ve h_agg acik degerler: etiket yalnizca tam dogrulanan
+                // gosterim icin alinir, burada sadece ucuz on eleme yapilir
+                ShowTag tag = computeShowTag(com, aggH);
+                if (index.contains(tag)) {
+                    continue;
+                }
+                loadElement(h, batch.show_h, i);
+                loadElement(s, batch.show_s, i);
+                loadElement(k, batch.show_k, i);
+                if (!pairingCheckElements(params, h, s, k)) {
+                    continue;
+                }
+                loadElement(c, batch.show_c, i);
+                loadElement(s1, batch.show_s1, i);
+                loadElement(s2, batch.show_s2, i);
+                loadElement(s3, batch.show_s3, i);
+                pending.push_back(i);
+                tags.push_back(tag);
+                transcripts.push_back(koRVerifyTranscript(params, k, c, s1, s2, s3, mvk, com, aggH));
+            }
+            std::vector<unsigned char> digests(transcripts.size() * SHA512_DIGEST_LENGTH);
+            hashMany(transcripts, digests.data());
+            size_t localValid = 0;
+            for (size_t j = 0; j < pending.size(); j++) {
+                loadElement(c, batch.show_c, pending[j]);
+                if (!koRChallengeMatches(params, &digests[j * SHA512_DIGEST_LENGTH], c)) {
+                    continue;
+                }
+                // Eklemeyi kaybeden gecerli gosterim ikinci gosterimdir
+                if (!index.insertIfAbsent(tags[j])) {
+                    continue;
+                }
+                ok[pending[j]] = 1;
+                localValid++;
+            }
+            valid.fetch_add(localValid, std::memory_order_relaxed);
+        });
+    return valid.load();
+}
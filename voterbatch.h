@@ -0,0 +1,68 @@
+#ifndef VOTERBATCH_H
+#define VOTERBATCH_H
+
+#include "setup.h"
+#include "keygen.h"
+#include "prepareblindsign.h"
+#include "aggregate.h"
+#include "provecredential.h"
+#include "tally.h"
+#include "doubleshow.h"
+#include <cstddef>
+#include <vector>
+
+// Sabit genislikli eleman sutunu. i. secmenin degeri
+// data[i * width, (i + 1) * width) araligindadir (element_to_bytes formati),
+// bu yuzden tampon oldugu gibi diske ya da aga yazilabilir. Sutunlara
+// yalnizca acik degerler yazilir; secmenin gizli acilimi (o) ve ihrac ara
+// degerleri PrepareBlindSignOutput'ta kalir.
+struct ElementColumn {
+    size_t width = 0;
+    std::vector<unsigned char> data;
+
+    unsigned char *slot(size_t i) { return data.data() + i * width; }
+    const unsigned char *slot(size_t i) const { return data.data() + i * width; }
+};
+
+// Gosterim dogrulama ve sayim icin secmen basina durumun struct-of-arrays
+// yerlesimi: her alan tum secmenler icin tek bir bitisik dizidir. Ihrac
+// asamalari struct'larla calisir, batch ihrac bittikten sonra doldurulur.
+struct VoterBatch {
+    size_t count = 0;
+    // Gosterim etiketi: com ve h_agg
+    ElementColumn com;
+    ElementColumn agg_h;
+    // proveCredential + KoR
+    ElementColumn show_h;
+    ElementColumn show_s;
+    ElementColumn show_k;
+    ElementColumn show_c;
+    ElementColumn show_s1;
+    ElementColumn show_s2;
+    ElementColumn show_s3;
+    // encryptBallot
+    ElementColumn ballot_c1;
+    ElementColumn ballot_c2;
+};
+
+void initVoterBatch(TIACParams &params, VoterBatch &batch, size_t count);
+
+void storeElement(ElementColumn &col, size_t i, element_t e);
+void loadElement(element_t e, const ElementColumn &col, size_t i);
+
+void storeCredential(VoterBatch &batch, size_t i, PrepareBlindSignOutput &prep, AggregateSignature &agg, ProveCredentialOutput &proof);
+void storeBallot(VoterBatch &batch, size_t i, Ballot &ballot);
+
+// Batch dogrulama: double-show indeksinde ucuz on eleme (contains), pairing
+// ve KoR kontrolu, en son etiketin eklenmesi. Etiket yalnizca tam dogrulanan
+// gosterim icin alinir; sahte bir gosterim gercegini kilitleyemez.
+// ok[i] == 1 ise i. gosterim gecerli ve ilk kez gorulmus demektir.
+size_t verifyShowBatch(
+    TIACParams &params,
+    const MasterVerKey &mvk,
+    const VoterBatch &batch,
+    DoubleShowIndex &index,
+    std::vector<char> &ok
+);
+
+#endif
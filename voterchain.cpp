@@ -0,0 +1,195 @@
+#include "voterchain.h"
+#include "prepareblindsign.h"
+#include "blindsign.h"
+#include "unblindsign.h"
+#include "aggregate.h"
+#include "provecredential.h"
+#include "kor.h"
+#include "pairinginverify.h"
+#include "checkkorverify.h"
+#include "doubleshow.h"
+#include "rng.h"
+#include "trace.h"
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#include <tbb/partitioner.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <utility>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct AtomicStageTimes {
+    std::atomic<long long> prep_us{0};
+    std::atomic<long long> blind_us{0};
+    std::atomic<long long> unblind_us{0};
+    std::atomic<long long> aggregate_us{0};
+    std::atomic<long long> prove_us{0};
+    std::atomic<long long> kor_us{0};
+    std::atomic<long long> verify_us{0};
+};
+
+// Asama saati: her lap() bir onceki noktadan bu yana gecen sureyi dondurur
+struct StageClock {
+    Clock::time_point start = Clock::now();
+    Clock::time_point last = start;
+
+    long long lap() {
+        auto now = Clock::now();
+        long long us = std::chrono::duration_cast<std::chrono::microseconds>(now - last).count();
+        last = now;
+        return us;
+    }
+    long long total() const {
+        return std::chrono::duration_cast<std::chrono::microseconds>(last - start).count();
+    }
+};
+
+}
+
+void issueCredential(TIACParams &params, KeyGenOutput &keyOut, const std::string &did, const std::vector<int> &admins, int voterId, IssuedCredential &out, ChainStageTimes *times) {
+    const int t = (int)admins.size();
+    StageClock clk;
+
+    {
+        TRACE_SPAN("prepare", voterId);
+        out.prepared = prepareBlindSign(params, did);
+    }
+    if (times) times->prep_us += clk.lap();
+
+    std::vector<BlindSignature> sigs(t);
+    for (int j = 0; j < t; j++) {
+        int aId = admins[j];
+        TRACE_SPAN("sign", voterId);
+        sigs[j] = blindSign(params, out.prepared, keyOut.eaKeys[aId].sgk1, keyOut.eaKeys[aId].sgk2, aId, voterId);
+    }
+    if (times) times->blind_us += clk.lap();
+
+    std::vector<std::pair<int, UnblindSignature>> partials;
+    partials.reserve(t);
+    for (auto &sig : sigs) {
+        int adminId = sig.adminId;
+        TRACE_SPAN("unblind", voterId);
+        partials.emplace_back(adminId, unblindSign(params, out.prepared, sig, keyOut.eaKeys[adminId]));
+    }
+    if (times) times->unblind_us += clk.lap();
+
+    {
+        TRACE_SPAN("aggregate", voterId);
+        out.agg = aggregateSign(params, partials, keyOut.mvk, did, params.prime_order);
+    }
+    if (times) times->aggregate_us += clk.lap();
+
+    {
+        TRACE_SPAN("prove", voterId);
+        out.proof = proveCredential(params, out.agg, keyOut.mvk, out.prepared.did, out.prepared.o);
+    }
+    if (times) times->prove_us += clk.lap();
+
+    TRACE_SPAN("KoR", voterId);
+    KnowledgeOfRepProof korProof = generateKoRProof(
+        params,
+        out.prepared,
+        out.proof.k,
+        out.proof.r,
+        keyOut.mvk.alpha2,
+        keyOut.mvk.beta2
+    );
+    element_set(out.proof.c, korProof.c);
+    element_set(out.proof.s1, korProof.s1);
+    element_set(out.proof.s2, korProof.s2);
+    element_set(out.proof.s3, korProof.s3);
+    out.proof.proof_v = korProof.proof_string;
+    if (times) times->kor_us += clk.lap();
+}
+
+bool verifyCredential(TIACParams &params, KeyGenOutput &keyOut, IssuedCredential &cred) {
+    ProveCredentialOutput &proof = cred.proof;
+    return pairingCheckElements(params, proof.sigmaRnd.h, proof.sigmaRnd.s, proof.k)
+        && checkKoRVerifyElements(params, proof.k, proof.c, proof.s1, proof.s2, proof.s3, keyOut.mvk, cred.prepared.com, cred.agg.h);
+}
+
+ChainReport runVoterChains(TIACParams &params, KeyGenOutput &keyOut, const std::vector<DID> &dids, const std::vector<std::vector<int>> &adminSets) {
+    const int voterCount = (int)dids.size();
+    if ((int)adminSets.size() != voterCount) {
+        throw std::runtime_error("runVoterChains: adminSets size does not match voter count");
+    }
+
+    ChainReport report;
+    report.ok.assign(voterCount, 0);
+    std::vector<long long> latency(voterCount, 0);
+    AtomicStageTimes times;
+    std::atomic<size_t> verified(0);
+    DoubleShowIndex showIndex(voterCount);
+
+    auto wallStart = Clock::now();
+    // simple_partitioner + grain 1: her secmen ayri bir gorev, bos kalan
+    // isci digerlerinin kuyrugundan calar
+    tbb::parallel_for(tbb::blocked_range<int>(0, voterCount, 1),
+        [&](const tbb::blocked_range<int> &r) {
+            for (int i = r.begin(); i != r.end(); ++i) {
+                const std::string &did = dids[i].did;
+                const std::vector<int> &admins = adminSets[i];
+                // Deterministik modda secmenin akisi hangi iscide kostugundan bagimsiz
+                RandomStreamScope stream((uint64_t)i);
+                TRACE_SPAN("voter", i);
+                StageClock clk;
+
+                IssuedCredential cred;
+                ChainStageTimes local;
+                issueCredential(params, keyOut, did, admins, i, cred, &local);
+                times.prep_us.fetch_add(local.prep_us, std::memory_order_relaxed);
+                times.blind_us.fetch_add(local.blind_us, std::memory_order_relaxed);
+                times.unblind_us.fetch_add(local.unblind_us, std::memory_order_relaxed);
+                times.aggregate_us.fetch_add(local.aggregate_us, std::memory_order_relaxed);
+                times.prove_us.fetch_add(local.prove_us, std::memory_order_relaxed);
+                times.kor_us.fetch_add(local.kor_us, std::memory_order_relaxed);
+                clk.lap();
+
+                bool ok;
+                {
+                    TRACE_SPAN("verify", i);
+                    // Etiket yalnizca dogrulanan gosterim icin alinir
+                    ShowTag tag = computeShowTag(cred.prepared.com, cred.agg.h);
+                    ok = !showIndex.contains(tag)
+                        && verifyCredential(params, keyOut, cred)
+                        && showIndex.insertIfAbsent(tag);
+                }
+                times.verify_us.fetch_add(clk.lap(), std::memory_order_relaxed);
+
+                if (ok) {
+                    report.ok[i] = 1;
+                    verified.fetch_add(1, std::memory_order_relaxed);
+                }
+                latency[i] = clk.total();
+            }
+        },
+        tbb::simple_partitioner());
+    report.wall_us = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - wallStart).count();
+
+    report.times.prep_us = times.prep_us.load();
+    report.times.blind_us = times.blind_us.load();
+    report.times.unblind_us = times.unblind_us.load();
+    report.times.aggregate_us = times.aggregate_us.load();
+    report.times.prove_us = times.prove_us.load();
+    report.times.kor_us = times.kor_us.load();
+    report.times.verify_us = times.verify_us.load();
+    report.verified = verified.load();
+
+    if (voterCount > 0) {
+        long long sum = 0;
+        for (long long l : latency) {
+            sum += l;
+        }
+        report.latencyMean_us = (double)sum / voterCount;
+        std::sort(latency.begin(), latency.end());
+        report.latencyP50_us = latency[(size_t)(voterCount - 1) * 50 / 100];
+        report.latencyP99_us = latency[(size_t)(voterCount - 1) * 99 / 100];
+        report.latencyMax_us = latency.back();
+    }
+    return report;
+}
@@ -0,0 +1,74 @@
+#ifndef VOTERCHAIN_H
+#define VOTERCHAIN_H
+
+#include "setup.h"
+#include "keygen.h"
+#include "didgen.h"
+#include "prepareblindsign.h"
+#include "aggregate.h"
+#include "provecredential.h"
+#include <string>
+#include <vector>
+
+// Asama basina tum isciler uzerinden toplanan sure (mikrosaniye).
+// Zincir modunda asamalar ust uste bindigi icin bunlar duvar saati degil,
+// o asamada harcanan toplam CPU zamanidir.
+struct ChainStageTimes {
+    long long prep_us = 0;
+    long long blind_us = 0;
+    long long unblind_us = 0;
+    long long aggregate_us = 0;
+    long long prove_us = 0;
+    long long kor_us = 0;
+    long long verify_us = 0;
+};
+
+struct ChainReport {
+    ChainStageTimes times;
+    long long wall_us = 0;
+    // Secmen basina gecikme: zincirin ilk asamasindan dogrulamanin sonuna
+    double latencyMean_us = 0;
+    long long latencyP50_us = 0;
+    long long latencyP99_us = 0;
+    long long latencyMax_us = 0;
+    size_t verified = 0;
+    std::vector<char> ok;
+};
+
+// Tek secmenin ihrac zincirinin ciktisi: gosterim (proof + com + agg.h) ve
+// prepare durumu.
+struct IssuedCredential {
+    PrepareBlindSignOutput prepared;
+    AggregateSignature agg;
+    ProveCredentialOutput proof;
+};
+
+// prepare -> t x blind -> unblind -> aggregate -> prove -> KoR. EA gizli
+// anahtarlari keyOut.eaKeys'ten dogrudan kullanilir. times verilirse asama
+// sureleri (mikrosaniye) ona eklenir; verify_us dokunulmaz.
+void issueCredential(
+    TIACParams &params,
+    KeyGenOutput &keyOut,
+    const std::string &did,
+    const std::vector<int> &admins,
+    int voterId,
+    IssuedCredential &out,
+    ChainStageTimes *times
+);
+
+// Gosterimin pairing + KoR kontrolu (double-show indeksi haric).
+bool verifyCredential(TIACParams &params, KeyGenOutput &keyOut, IssuedCredential &cred);
+
+// Her secmenin prepare -> blind -> unblind -> aggregate -> prove -> KoR ->
+// verify adimlarini tek bir TBB gorevi icinde sirayla calistirir. Gorevler
+// work-stealing havuzuna dagitilir; asamalar arasinda bariyer yoktur, ara
+// sonuclar ayni cekirdekte bir sonraki asamaya yerel degisken olarak gecer.
+// adminSets[i], i. secmenin imza alacagi t EA indeksidir.
+ChainReport runVoterChains(
+    TIACParams &params,
+    KeyGenOutput &keyOut,
+    const std::vector<DID> &dids,
+    const std::vector<std::vector<int>> &adminSets
+);
+
+#endif
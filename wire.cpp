@@ -0,0 +1,352 @@
+#include "wire.h"
+#include "scratch.h"
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+struct Writer {
+    const WireCodec &codec;
+    unsigned char *p;
+
+    void u32(uint32_t v) {
+        for (int i = 0; i < 4; i++) {
+            *p++ = (unsigned char)(v >> (8 * i));
+        }
+    }
+    void g1(element_s *e) {
+        element_to_bytes_compressed(p, e);
+        p += codec.g1;
+    }
+    void g2(element_s *e) {
+        element_to_bytes_compressed(p, e);
+        p += codec.g2;
+    }
+    void zr(element_s *e) {
+        size_t pad = kWireZrBytes - codec.zr;
+        std::memset(p, 0, pad);
+        element_to_bytes(p + pad, e);
+        p += kWireZrBytes;
+    }
+};
+
+// G1 ve G2 tip A'da ayni egri: y^2 = x^3 + x. Sikistirilmis kodlamadan
+// cozulen nokta, f(x) kare degilse egri disina duser; ayrica kofaktor
+// bileseni tasiyan nokta uzerindeki us alma gizli anahtari kucuk
+// carpanlar modulunde sizdirabilir.
+// Big-endian byte dizisini n limb'e (kucuk limb once) yazar
+void limbsFromBytes(mp_limb_t *out, size_t n, const unsigned char *in, size_t len) {
+    std::memset(out, 0, n * sizeof(mp_limb_t));
+    for (size_t i = 0; i < len; i++) {
+        size_t bit = 8 * (len - 1 - i);
+        out[bit / GMP_NUMB_BITS] |= (mp_limb_t)in[i] << (bit % GMP_NUMB_BITS);
+    }
+}
+
+// out = a * b mod q; a, b < q ve n limb
+void mulMod(const WireCodec &codec, mp_limb_t *out, const mp_limb_t *a, const mp_limb_t *b) {
+    const size_t n = codec.fieldLimbs;
+    mp_limb_t prod[2 * kWireMaxLimbs], quot[kWireMaxLimbs + 1];
+    mpn_mul_n(prod, a, b, n);
+    mpn_tdiv_qr(quot, out, 0, prod, 2 * n, codec.field, n);
+}
+
+void checkPoint(const WireCodec &codec, element_s *e, Group group) {
+    unsigned char buf[4 * kWireMaxLimbs * sizeof(mp_limb_t)];
+    int len = element_length_in_bytes(e);
+    if (len <= 0 || (size_t)len > sizeof(buf)) {
+        throw std::runtime_error("wire: unexpected point encoding size");
+    }
+    element_to_bytes(buf, e);
+    const size_t n = codec.fieldLimbs;
+    size_t half = (size_t)len / 2;
+    if (half > n * sizeof(mp_limb_t)) {
+        throw std::runtime_error("wire: unexpected point encoding size");
+    }
+    // y^2 == (x^2 + 1) * x mod q
+    mp_limb_t x[kWireMaxLimbs], y[kWireMaxLimbs], lhs[kWireMaxLimbs], rhs[kWireMaxLimbs];
+    limbsFromBytes(x, n, buf, half);
+    limbsFromBytes(y, n, buf + half, half);
+    mulMod(codec, rhs, x, x);
+    // x^2 mod q <= q - 1, +1 tasmaz; q'ya esitse 0'a indir
+    mpn_add_1(rhs, rhs, n, 1);
+    if (mpn_cmp(rhs, codec.field, n) == 0) {
+        std::memset(rhs, 0, n * sizeof(mp_limb_t));
+    }
+    mulMod(codec, rhs, rhs, x);
+    mulMod(codec, lhs, y, y);
+    if (mpn_cmp(lhs, rhs, n) != 0) {
+        throw std::runtime_error("wire: point not on curve");
+    }
+    ScratchFrame scratch(codec.pairing);
+    element_s *t = scratch.take(group);
+    element_pow_mpz(t, e, codec.pairing->r);
+    if (!element_is1(t)) {
+        throw std::runtime_error("wire: point not in order-r subgroup");
+    }
+}
+
+struct Reader {
+    const WireCodec &codec;
+    const unsigned char *p;
+
+    uint32_t u32() {
+        uint32_t v = 0;
+        for (int i = 0; i < 4; i++) {
+            v |= (uint32_t)(*p++) << (8 * i);
+        }
+        return v;
+    }
+    void g1(element_s *e) {
+        element_from_bytes_compressed(e, const_cast<unsigned char*>(p));
+        checkPoint(codec, e, Group::G1);
+        p += codec.g1;
+    }
+    void g2(element_s *e) {
+        element_from_bytes_compressed(e, const_cast<unsigned char*>(p));
+        checkPoint(codec, e, Group::G2);
+        p += codec.g2;
+    }
+    void zr(element_s *e) {
+        // element_from_bytes r'yi asan degeri sessizce indirger; dolgu dahil
+        // big-endian karsilastirma >= r olan her degeri reddeder
+        if (std::memcmp(p, codec.order, kWireZrBytes) >= 0) {
+            throw std::runtime_error("wire: non-canonical Zr value");
+        }
+        size_t pad = kWireZrBytes - codec.zr;
+        element_from_bytes(e, const_cast<unsigned char*>(p + pad));
+        p += kWireZrBytes;
+    }
+};
+
+Writer beginFrame(const WireCodec &codec, WireType type, unsigned char *out) {
+    Writer w{codec, out};
+    w.u32((uint32_t)wireBodySize(codec, type));
+    *w.p++ = (unsigned char)type;
+    return w;
+}
+
+Reader beginDecode(const WireCodec &codec, WireType expected, const unsigned char *in, size_t len) {
+    WireType type;
+    size_t frameLen;
+    if (!peekWireFrame(in, len, type, frameLen) || frameLen > len) {
+        throw std::runtime_error("wire: truncated frame");
+    }
+    if (type != expected) {
+        throw std::runtime_error("wire: unexpected message type " + std::to_string((int)type));
+    }
+    if (frameLen != wireFrameSize(codec, type)) {
+        throw std::runtime_error("wire: body length does not match message type");
+    }
+    return Reader{codec, in + kWireHeaderBytes};
+}
+
+}
+
+WireCodec makeWireCodec(TIACParams &params) {
+    WireCodec codec;
+    codec.g1 = (size_t)pairing_length_in_bytes_compressed_G1(params.pairing);
+    codec.g2 = (size_t)pairing_length_in_bytes_compressed_G2(params.pairing);
+    codec.zr = (size_t)pairing_length_in_bytes_Zr(params.pairing);
+    codec.pairing = params.pairing;
+    if (codec.zr > kWireZrBytes) {
+        throw std::runtime_error("makeWireCodec: Zr wider than 32 bytes");
+    }
+    size_t orderBytes = (mpz_sizeinbase(params.prime_order, 2) + 7) / 8;
+    if (orderBytes > kWireZrBytes) {
+        throw std::runtime_error("makeWireCodec: group order wider than 32 bytes");
+    }
+    mpz_export(codec.order + kWireZrBytes - orderBytes, nullptr, 1, 1, 0, 0, params.prime_order);
+    codec.fieldLimbs = mpz_size(params.field_order);
+    if (codec.fieldLimbs == 0 || codec.fieldLimbs > kWireMaxLimbs) {
+        throw std::runtime_error("makeWireCodec: field order wider than kWireMaxLimbs limbs");
+    }
+    for (size_t i = 0; i < codec.fieldLimbs; i++) {
+        codec.field[i] = mpz_getlimbn(params.field_order, (mp_size_t)i);
+    }
+    return codec;
+}
+
+size_t wireBodySize(const WireCodec &codec, WireType type) {
+    switch (type) {
+    case WireType::PrepareRequest:
+        return 4 + 3 * codec.g1 + 4 * kWireZrBytes;
+    case WireType::BlindSignature:
+        return 8 + 2 * codec.g1;
+    case WireType::PartialSignature:
+        return 4 + 2 * codec.g1;
+    case WireType::AggregateCredential:
+        return 2 * codec.g1;
+    case WireType::ShowProof:
+        return 4 * codec.g1 + codec.g2 + 4 * kWireZrBytes;
+    case WireType::SignError:
+        return 4;
+    }
+    throw std::runtime_error("wireBodySize: unknown message type");
+}
+
+bool peekWireFrame(const unsigned char *in, size_t len, WireType &type, size_t &frameLen) {
+    if (len < kWireHeaderBytes) {
+        return false;
+    }
+    uint32_t body = (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+    type = (WireType)in[4];
+    frameLen = kWireHeaderBytes + body;
+    return true;
+}
+
+size_t encodePrepareRequest(const WireCodec &codec, int voterId, const PrepareBlindSignOutput &prep, unsigned char *out) {
+    Writer w = beginFrame(codec, WireType::PrepareRequest, out);
+    w.u32((uint32_t)voterId);
+    w.g1(prep.comi);
+    w.g1(prep.h);
+    w.g1(prep.com);
+    w.zr(prep.pi_s.c);
+    w.zr(prep.pi_s.s1);
+    w.zr(prep.pi_s.s2);
+    w.zr(prep.pi_s.s3);
+    return w.p - out;
+}
+
+size_t encodeBlindSignature(const WireCodec &codec, const BlindSignature &sig, unsigned char *out) {
+    Writer w = beginFrame(codec, WireType::BlindSignature, out);
+    w.u32((uint32_t)sig.adminId);
+    w.u32((uint32_t)sig.voterId);
+    w.g1(sig.h);
+    w.g1(sig.cm);
+    return w.p - out;
+}
+
+size_t encodePartialSignature(const WireCodec &codec, int adminId, const UnblindSignature &sig, unsigned char *out) {
+    Writer w = beginFrame(codec, WireType::PartialSignature, out);
+    w.u32((uint32_t)adminId);
+    w.g1(sig.h);
+    w.g1(sig.s_m);
+    return w.p - out;
+}
+
+size_t encodeAggregateCredential(const WireCodec &codec, const AggregateSignature &agg, unsigned char *out) {
+    Writer w = beginFrame(codec, WireType::AggregateCredential, out);
+    w.g1(agg.h);
+    w.g1(agg.s);
+    return w.p - out;
+}
+
+size_t encodeShowProof(const WireCodec &codec, const ProveCredentialOutput &proof, const Element &com, const Element &h_agg, unsigned char *out) {
+    Writer w = beginFrame(codec, WireType::ShowProof, out);
+    w.g1(proof.sigmaRnd.h);
+    w.g1(proof.sigmaRnd.s);
+    w.g2(proof.k);
+    w.zr(proof.c);
+    w.zr(proof.s1);
+    w.zr(proof.s2);
+    w.zr(proof.s3);
+    w.g1(com);
+    w.g1(h_agg);
+    return w.p - out;
+}
+
+size_t encodeSignError(const WireCodec &codec, int voterId, unsigned char *out) {
+    Writer w = beginFrame(codec, WireType::SignError, out);
+    w.u32((uint32_t)voterId);
+    return w.p - out;
+}
+
+void initPrepareRequest(TIACParams &params, PrepareBlindSignOutput &prep) {
+    prep.comi.init(params.pairing, Group::G1);
+    prep.h.init(params.pairing, Group::G1);
+    prep.com.init(params.pairing, Group::G1);
+    prep.pi_s.c.init(params.pairing, Group::Zr);
+    prep.pi_s.s1.init(params.pairing, Group::Zr);
+    prep.pi_s.s2.init(params.pairing, Group::Zr);
+    prep.pi_s.s3.init(params.pairing, Group::Zr);
+}
+
+void initBlindSignature(TIACParams &params, BlindSignature &sig) {
+    sig.h.init(params.pairing, Group::G1);
+    sig.cm.init(params.pairing, Group::G1);
+}
+
+void initPartialSignature(TIACParams &params, UnblindSignature &sig) {
+    sig.h.init(params.pairing, Group::G1);
+    sig.s_m.init(params.pairing, Group::G1);
+}
+
+void initAggregateCredential(TIACParams &params, AggregateSignature &agg) {
+    agg.h.init(params.pairing, Group::G1);
+    agg.s.init(params.pairing, Group::G1);
+}
+
+void initShowProof(TIACParams &params, ProveCredentialOutput &proof, Element &com, Element &h_agg) {
+    proof.sigmaRnd.h.init(params.pairing, Group::G1);
+    proof.sigmaRnd.s.init(params.pairing, Group::G1);
+    proof.k.init(params.pairing, Group::G2);
+    proof.c.init(params.pairing, Group::Zr);
+    proof.s1.init(params.pairing, Group::Zr);
+    proof.s2.init(params.pairing, Group::Zr);
+    proof.s3.init(params.pairing, Group::Zr);
+    com.init(params.pairing, Group::G1);
+    h_agg.init(params.pairing, Group::G1);
+}
+
+size_t decodePrepareRequest(const WireCodec &codec, const unsigned char *in, size_t len, int &voterId, PrepareBlindSignOutput &prep) {
+    Reader r = beginDecode(codec, WireType::PrepareRequest, in, len);
+    voterId = (int)r.u32();
+    r.g1(prep.comi);
+    r.g1(prep.h);
+    r.g1(prep.com);
+    r.zr(prep.pi_s.c);
+    r.zr(prep.pi_s.s1);
+    r.zr(prep.pi_s.s2);
+    r.zr(prep.pi_s.s3);
+    // Onbellekli kodlamalar onceki istekten kalmasin (imzalayan kullanmaz)
+    prep.comi_str.clear();
+    prep.h_str.clear();
+    prep.com_str.clear();
+    return r.p - in;
+}
+
+size_t decodeBlindSignature(const WireCodec &codec, const unsigned char *in, size_t len, BlindSignature &sig) {
+    Reader r = beginDecode(codec, WireType::BlindSignature, in, len);
+    sig.adminId = (int)r.u32();
+    sig.voterId = (int)r.u32();
+    r.g1(sig.h);
+    r.g1(sig.cm);
+    return r.p - in;
+}
+
+size_t decodePartialSignature(const WireCodec &codec, const unsigned char *in, size_t len, int &adminId, UnblindSignature &sig) {
+    Reader r = beginDecode(codec, WireType::PartialSignature, in, len);
+    adminId = (int)r.u32();
+    r.g1(sig.h);
+    r.g1(sig.s_m);
+    return r.p - in;
+}
+
+size_t decodeAggregateCredential(const WireCodec &codec, const unsigned char *in, size_t len, AggregateSignature &agg) {
+    Reader r = beginDecode(codec, WireType::AggregateCredential, in, len);
+    r.g1(agg.h);
+    r.g1(agg.s);
+    return r.p - in;
+}
+
+size_t decodeShowProof(const WireCodec &codec, const unsigned char *in, size_t len, ProveCredentialOutput &proof, Element &com, Element &h_agg) {
+    Reader r = beginDecode(codec, WireType::ShowProof, in, len);
+    r.g1(proof.sigmaRnd.h);
+    r.g1(proof.sigmaRnd.s);
+    r.g2(proof.k);
+    r.zr(proof.c);
+    r.zr(proof.s1);
+    r.zr(proof.s2);
+    r.zr(proof.s3);
+    r.g1(com);
+    r.g1(h_agg);
+    return r.p - in;
+}
+
+size_t decodeSignError(const WireCodec &codec, const unsigned char *in, size_t len, int &voterId) {
+    Reader r = beginDecode(codec, WireType::SignError, in, len);
+    voterId = (int)r.u32();
+    return r.p - in;
+}
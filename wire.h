@@ -0,0 +1,87 @@
+#ifndef WIRE_H
+#define WIRE_H
+
+#include "setup.h"
+#include "prepareblindsign.h"
+#include "blindsign.h"
+#include "unblindsign.h"
+#include "aggregate.h"
+#include "provecredential.h"
+#include <cstddef>
+#include <cstdint>
+
+// Protokol mesajlari icin ikili cerceve:
+//   u32 LE govde uzunlugu | u8 tip | govde
+// G1/G2 noktalari sikistirilmis (x + isaret byte'i), Zr degerleri sabit 32
+// byte big-endian, tamsayilar u32 LE. Cozme islemi cagiranin onceden init
+// ettigi Element'lere yazar. Girdi guvenilmez sayilir: her nokta icin egri
+// denklemi ve P^r == 1 (kofaktor bileseni yok), her Zr degeri icin < r
+// kontrol edilir; uymayan cerceve runtime_error ile reddedilir. Egri ve Zr
+// kontrolleri codec'teki limb/byte kopyalariyla, ayirma yapmadan yapilir.
+// P^r == 1 ise nokta basina tam bir us alma (|r| bitlik, kabaca bir
+// element_pow_zn) demektir ve cozme suresine hakimdir: ShowProof'ta 5 nokta
+// vardir, olculen cozme suresi bu kontrolleri icerir.
+
+enum class WireType : uint8_t {
+    PrepareRequest = 1,      // voterId, comi, h, com, pi_s (c, s1, s2, s3)
+    BlindSignature = 2,      // adminId, voterId, h, cm
+    PartialSignature = 3,    // adminId, h, s_m
+    AggregateCredential = 4, // h, s
+    ShowProof = 5,           // sigmaRnd.h, sigmaRnd.s, k, c, s1, s2, s3, com, h_agg
+    SignError = 6            // voterId (istek reddedildi: KoR ya da hash kontrolu)
+};
+
+const size_t kWireHeaderBytes = 5;
+const size_t kWireZrBytes = 32;
+// Egri kontrolundeki taban alani icin limb siniri (1024 bit)
+const size_t kWireMaxLimbs = 16;
+
+struct WireCodec {
+    size_t g1 = 0;
+    size_t g2 = 0;
+    size_t zr = 0;
+    // Alt grup kontrolu icin; makeWireCodec'e verilen params'a aittir
+    pairing_ptr pairing = nullptr;
+    // Taban alani q, kucuk limb once
+    size_t fieldLimbs = 0;
+    mp_limb_t field[kWireMaxLimbs] = {};
+    // Grup mertebesi r, kWireZrBytes genislikte big-endian
+    unsigned char order[kWireZrBytes] = {};
+};
+
+WireCodec makeWireCodec(TIACParams &params);
+
+size_t wireBodySize(const WireCodec &codec, WireType type);
+inline size_t wireFrameSize(const WireCodec &codec, WireType type) {
+    return kWireHeaderBytes + wireBodySize(codec, type);
+}
+
+// Tampon en az bir baslik kadar ise tipi ve tum cerceve uzunlugunu doner.
+// Cerceve henuz tamamlanmamis olabilir (frameLen > len).
+bool peekWireFrame(const unsigned char *in, size_t len, WireType &type, size_t &frameLen);
+
+// out en az wireFrameSize(codec, tip) byte olmali; yazilan byte sayisini doner.
+size_t encodePrepareRequest(const WireCodec &codec, int voterId, const PrepareBlindSignOutput &prep, unsigned char *out);
+size_t encodeBlindSignature(const WireCodec &codec, const BlindSignature &sig, unsigned char *out);
+size_t encodePartialSignature(const WireCodec &codec, int adminId, const UnblindSignature &sig, unsigned char *out);
+size_t encodeAggregateCredential(const WireCodec &codec, const AggregateSignature &agg, unsigned char *out);
+size_t encodeShowProof(const WireCodec &codec, const ProveCredentialOutput &proof, const Element &com, const Element &h_agg, unsigned char *out);
+size_t encodeSignError(const WireCodec &codec, int voterId, unsigned char *out);
+
+// Hedef Element'leri dogru gruplarda init eder (cozmeden once bir kez).
+void initPrepareRequest(TIACParams &params, PrepareBlindSignOutput &prep);
+void initBlindSignature(TIACParams &params, BlindSignature &sig);
+void initPartialSignature(TIACParams &params, UnblindSignature &sig);
+void initAggregateCredential(TIACParams &params, AggregateSignature &agg);
+void initShowProof(TIACParams &params, ProveCredentialOutput &proof, Element &com, Element &h_agg);
+
+// Tam bir cerceveyi cozer ve tukettigi byte sayisini doner. Tip, uzunluk
+// ya da Zr dolgusu uyusmazsa std::runtime_error firlatir.
+size_t decodePrepareRequest(const WireCodec &codec, const unsigned char *in, size_t len, int &voterId, PrepareBlindSignOutput &prep);
+size_t decodeBlindSignature(const WireCodec &codec, const unsigned char *in, size_t len, BlindSignature &sig);
+size_t decodePartialSignature(const WireCodec &codec, const unsigned char *in, size_t len, int &adminId, UnblindSignature &sig);
+size_t decodeAggregateCredential(const WireCodec &codec, const unsigned char *in, size_t len, AggregateSignature &agg);
+size_t decodeShowProof(const WireCodec &codec, const unsigned char *in, size_t len, ProveCredentialOutput &proof, Element &com, Element &h_agg);
+size_t decodeSignError(const WireCodec &codec, const unsigned char *in, size_t len, int &voterId);
+
+#endif